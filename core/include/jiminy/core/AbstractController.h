@@ -122,6 +122,34 @@ namespace jiminy
         result_t registerConstant(std::string const & fieldName,
                                   T           const & value);
 
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        ///
+        /// \brief      Register a sensor whose data will be read by index rather than by name.
+        ///
+        /// \details    The sensor is resolved once here, then every time the controller is reset
+        ///             since the layout of the sensors data may have changed, so that reading its
+        ///             data in 'computeCommand' does not involve any string lookup.
+        ///
+        /// \param[in]  sensorType      Type of the sensor
+        /// \param[in]  sensorName      Name of the sensor
+        /// \param[out] sensorIdx       Index to pass to 'getSensorData'
+        ///
+        /// \return     Return code to determine whether the execution of the method was successful.
+        ///
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        result_t registerSensor(std::string const & sensorType,
+                                std::string const & sensorName,
+                                uint32_t          & sensorIdx);
+
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        ///
+        /// \brief      Get the latest data of a sensor registered beforehand.
+        ///
+        /// \param[in]  sensorIdx       Index returned by 'registerSensor'
+        ///
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        Eigen::Ref<vectorN_t const> getSensorData(uint32_t const & sensorIdx) const;
+
         ///////////////////////////////////////////////////////////////////////////////////////////////
         ///
         /// \brief      Remove all variables dynamically registered to the telemetry.
@@ -278,9 +306,16 @@ namespace jiminy
         configHolder_t ctrlOptionsHolder_;      ///< Dictionary with the parameters of the controller
         TelemetrySender telemetrySender_;       ///< Telemetry sender of the controller used to register and update telemetry variables
 
+    private:
+        result_t getSensorSegment(std::string                   const & sensorType,
+                                  std::string                   const & sensorName,
+                                  std::pair<uint32_t, uint32_t>       & segment) const;
+
     private:
         std::vector<std::pair<std::string, float64_t const *> > registeredVariables_;    ///< Vector of dynamically registered telemetry variables
         std::vector<std::pair<std::string, std::string> > registeredConstants_;          ///< Vector of dynamically registered telemetry constants
+        std::vector<std::pair<std::string, std::string> > registeredSensors_;            ///< Type and name of the sensors registered for direct access
+        std::vector<std::pair<uint32_t, uint32_t> > registeredSensorsSegments_;          ///< Offset and size of the data of the registered sensors in the flat sensors data of the model
     };
 }
 
@@ -18,6 +18,7 @@
 namespace jiminy
 {
     class Model;
+    class Engine;
 
     class AbstractMotorBase;
 
@@ -29,10 +30,31 @@ namespace jiminy
     ///////////////////////////////////////////////////////////////////////////////////////////////
     struct MotorSharedDataHolder_t
     {
+        /// \brief Motors of the same type, whose actual torque is computed at once.
+        ///
+        /// \details The inputs and parameters of the motors are stored as structure of arrays,
+        ///          in the order of the motors of the bank.
+        struct motorBank_t
+        {
+            std::vector<AbstractMotorBase *> motors;    ///< Motors of the bank
+            std::vector<int32_t> motorsIdx;             ///< Indices of the motors in the buffer of actual torques
+            std::vector<int32_t> positionIdx;           ///< Indices of the motors in the configuration vector
+            std::vector<int32_t> velocityIdx;           ///< Indices of the motors in the velocity vector
+            bool_t isInitialized;                       ///< Whether or not every motor of the bank is initialized
+            vectorN_t q;                                ///< Configuration of the motors
+            vectorN_t v;                                ///< Velocity of the motors
+            vectorN_t a;                                ///< Acceleration of the motors
+            vectorN_t uCommand;                         ///< Command torque of the motors
+            vectorN_t u;                                ///< Actual torque of the motors
+            vectorN_t torqueLimit;                      ///< Torque limit of the motors, infinite if disabled
+            matrixN_t parameters;                       ///< Parameters specific to the type of motors, one column per parameter
+        };
+
         MotorSharedDataHolder_t(void) :
         data_(),
         motors_(),
-        num_(0)
+        num_(0),
+        banks_()
         {
             // Empty.
         };
@@ -42,12 +64,14 @@ namespace jiminy
         vectorN_t data_;                            ///< Buffer with current actual motor torque
         std::vector<AbstractMotorBase *> motors_;   ///< Vector of pointers to the motors
         int32_t num_;                               ///< Number of motors
+        std::vector<motorBank_t> banks_;            ///< Motors gathered by type. Empty if it must be refreshed
     };
 
     class AbstractMotorBase
     {
         /* AKA AbstractSensorBase */
         friend Model;
+        friend Engine;
 
     public:
         ///////////////////////////////////////////////////////////////////////////////////////////////
@@ -254,6 +278,17 @@ namespace jiminy
                                   vectorN_t const & a,
                                   vectorN_t const & uCommand);
 
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        /// \brief      Gather every motors by type, along with their indices and parameters.
+        ///
+        /// \details    The parameters of the motors are only taken into account by 'computeAllEffort'
+        ///             after calling this method.
+        ///
+        /// \remark     This method is not intended to be called manually. The Model to which the
+        ///             motor is added is taking care of it when its own `reset` method is called.
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        void refreshBanks(void);
+
         void clearDataBuffer(void);
 
     protected:
@@ -263,6 +298,22 @@ namespace jiminy
         ///////////////////////////////////////////////////////////////////////////////////////////////
         float64_t & data(void);
 
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        /// \brief      Fill the parameters specific to the type of motors of a bank.
+        ///
+        /// \details    It is called on the first motor of the bank. Nothing is done by default.
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        virtual void refreshBank(MotorSharedDataHolder_t::motorBank_t & bank) const;
+
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        /// \brief      Compute the actual torque of every motor of a bank at once.
+        ///
+        /// \details    It is called on the first motor of the bank, once its inputs have been
+        ///             gathered. The default implementation calls 'computeEffort' for each motor.
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        virtual result_t computeEffortBank(float64_t                            const & t,
+                                           MotorSharedDataHolder_t::motorBank_t       & bank);
+
     private:
         ///////////////////////////////////////////////////////////////////////////////////////////////
         /// \brief    Attach the sensor to a model
@@ -13,15 +13,12 @@
 #ifndef JIMINY_ABSTRACT_SENSOR_H
 #define JIMINY_ABSTRACT_SENSOR_H
 
-#include <boost/circular_buffer.hpp>
-
 #include "jiminy/core/TelemetrySender.h"
 #include "jiminy/core/Types.h"
 
 namespace jiminy
 {
-    static uint8_t const MIN_DELAY_BUFFER_RESERVE(20); ///< Minimum memory allocation is memory is full and the older data stored is dated less than the desired delay
-    static uint8_t const MAX_DELAY_BUFFER_EXCEED(20);  ///< Maximum number of data stored allowed to be dated more than the desired delay
+    static uint8_t const MIN_DELAY_BUFFER_RESERVE(20); ///< Minimum number of extra samples allocated for the history, in addition to the ones required by the delay
 
     class TelemetryData;
     class Model;
@@ -42,23 +39,128 @@ namespace jiminy
     ///////////////////////////////////////////////////////////////////////////////////////////////
     struct SensorSharedDataHolder_t
     {
+        /// \brief Sensors sharing the same delay, whose measurements are interpolated at once.
+        struct delayGroup_t
+        {
+            float64_t delay;
+            uint32_t delayInterpolationOrder;
+            std::vector<int32_t> sensorsIdx;    ///< Indices of the sensors of the group
+            uint32_t cursor;                    ///< Last delayed sample found, counted from the first sample since the reset
+        };
+
         SensorSharedDataHolder_t(void) :
         time_(),
         data_(),
+        historyHead_(0),
+        historySize_(0),
+        historyFirst_(0),
+        dataMeasuredStorage_(),
+        dataMeasured_(nullptr, 0, 0),
         sensors_(),
         num_(0),
-        delayMax_(0.0)
+        delayMax_(0.0),
+        delayGroups_(),
+        sensorsDelayGroupIdx_(),
+        noiseStd_(),
+        bias_(),
+        noise_(),
+        hasNoise_(false),
+        hasBias_(false)
         {
             // Empty.
         };
 
         ~SensorSharedDataHolder_t(void) = default;
 
-        boost::circular_buffer_space_optimized<float64_t> time_;    ///< Circular buffer of the stored timesteps
-        boost::circular_buffer_space_optimized<matrixN_t> data_;    ///< Circular buffer of past sensor data
+        // Disable the copy of the class, since the measurements may be stored in an external buffer
+        SensorSharedDataHolder_t(SensorSharedDataHolder_t const & other) = delete;
+        SensorSharedDataHolder_t & operator = (SensorSharedDataHolder_t const & other) = delete;
+
+        /// \brief Index in the ring buffers of the i-th oldest sample of the history.
+        uint32_t getHistoryIdx(uint32_t const & i) const
+        {
+            uint32_t const idx = historyHead_ + i;
+            return (idx < time_.size()) ? idx : idx - static_cast<uint32_t>(time_.size());
+        }
+
+        float64_t & time(uint32_t const & i)
+        {
+            return time_[getHistoryIdx(i)];
+        }
+
+        Eigen::Ref<vectorN_t> data(uint32_t const & i,
+                                   int32_t  const & sensorId)
+        {
+            return data_.col(getHistoryIdx(i) * num_ + sensorId);
+        }
+
+        /// \brief Reset the history to two samples of zero data, at time -1 and 0.
+        ///
+        /// \details The ring buffers are only reallocated if the layout of the data has changed,
+        ///          or if their capacity is lower than the one requested.
+        void clearHistory(uint32_t const & dataSize,
+                          uint32_t const & capacityMin);
+
+        /// \brief Append an uninitialized sample to the history.
+        ///
+        /// \details The capacity of the ring buffers is doubled if they are full, so that they
+        ///          are no longer reallocated once they are large enough for the delay.
+        void pushBackHistory(void);
+
+        void popFrontHistory(void)
+        {
+            historyHead_ = getHistoryIdx(1);
+            --historySize_;
+            ++historyFirst_;
+        }
+
+        void popBackHistory(void)
+        {
+            --historySize_;
+        }
+
+        /// \brief Resize the current measurements, keeping the ones of the first sensors.
+        ///
+        /// \details The measurements are moved back to the storage of the holder, until they
+        ///          are bound to the flat sensors data of the model again.
+        void resizeDataMeasured(uint32_t const & dataSize,
+                                int32_t  const & num);
+
+        /// \brief Move the current measurements to an external buffer, large enough to store them.
+        void bindDataMeasured(float64_t * data);
+
+        /// \brief Get the most recent sample of the history older than timeDesired, -1 if none.
+        ///
+        /// \details The search starts from the sample found previously for the same group, so
+        ///          that it is amortized constant time since the time is increasing.
+        int32_t findDelayedIdx(delayGroup_t       & group,
+                               float64_t    const & timeDesired);
+
+        /// \brief Gather the sensors by delay and interpolation order.
+        void refreshDelayGroups(void);
+
+        /// \brief Gather the noise level and the bias of every sensor, to add them all at once.
+        ///
+        /// \details The options whose size does not match the one of the data are ignored.
+        void refreshNoiseAndBias(uint32_t const & dataSize);
+
+        vectorN_t time_;                                            ///< Ring buffer of the stored timesteps
+        matrixN_t data_;                                            ///< Ring buffer of past sensor data. The data of every sensor at a given timestep are stored contiguously, one column per sensor
+        uint32_t historyHead_;                                      ///< Index in the ring buffers of the oldest sample
+        uint32_t historySize_;                                      ///< Number of samples stored in the ring buffers
+        uint32_t historyFirst_;                                     ///< Number of samples dropped since the reset, i.e. position of the oldest sample
+        vectorN_t dataMeasuredStorage_;                             ///< Storage of the current measurements, unless they are bound to the flat sensors data of the model
+        Eigen::Map<matrixN_t> dataMeasured_;                        ///< Current measurement of every sensor, one column per sensor. It avoids recomputing the same "current" measurement multiple times
         std::vector<AbstractSensorBase *> sensors_;                 ///< Vector of pointers to the sensors
         int32_t num_;                                               ///< Number of sensors of that type
         float64_t delayMax_;                                        ///< Maximum delay over all the sensors
+        std::vector<delayGroup_t> delayGroups_;                     ///< Sensors gathered by delay
+        std::vector<uint32_t> sensorsDelayGroupIdx_;                ///< Index of the delay group of each sensor
+        matrixN_t noiseStd_;                                        ///< Standard deviation of the noise of every sensor, one column per sensor
+        matrixN_t bias_;                                            ///< Bias of every sensor, one column per sensor
+        matrixN_t noise_;                                           ///< Preallocated buffer for the noise of every sensor
+        bool_t hasNoise_;                                           ///< Whether or not at least one sensor is noisy
+        bool_t hasBias_;                                            ///< Whether or not at least one sensor is biased
     };
 
     class AbstractSensorBase
@@ -271,7 +373,7 @@ namespace jiminy
         ///             a higher dimensional tensor.
         ///
         ///////////////////////////////////////////////////////////////////////////////////////////////
-        virtual vectorN_t const * get(void) = 0;
+        virtual Eigen::Ref<vectorN_t const> get(void) = 0;
 
         ///////////////////////////////////////////////////////////////////////////////////////////////
         ///
@@ -283,10 +385,12 @@ namespace jiminy
         ///             is used to compute the delayed measurement based on a buffer of previously
         ///             recorded non-delayed data.
         ///
-        /// \return     Eigen matrix where to store of measurement of all the sensors.
+        /// \return     Eigen matrix where to store of measurement of all the sensors, one column
+        ///             per sensor. It is only reallocated when a sensor of the same type is
+        ///             attached or detached.
         ///
         ///////////////////////////////////////////////////////////////////////////////////////////////
-        virtual matrixN_t getAll(void) = 0;
+        virtual Eigen::Ref<matrixN_t const> getAll(void) = 0;
 
         ///////////////////////////////////////////////////////////////////////////////////////////////
         ///
@@ -412,6 +516,15 @@ namespace jiminy
         virtual result_t updateDataBuffer(void) = 0;
         static result_t updateDataBuffer(AbstractSensorBase * base) { return base->updateDataBuffer(); }
 
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        /// \brief      Get the index of the frame whose kinematics is required by the sensor, -1 if none.
+        ///
+        /// \details    The kinematics of every frame required by the sensors is computed once by the
+        ///             model before updating them, so that the sensors sharing the same frame do not
+        ///             compute it several times.
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        virtual int32_t getKinematicsFrameIdx(void) const;
+
     public:
         std::unique_ptr<abstractSensorOptions_t const> baseSensorOptions_;    ///< Structure with the parameters of the sensor
 
@@ -422,7 +535,7 @@ namespace jiminy
         bool_t isTelemetryConfigured_;          ///< Flag to determine whether the telemetry of the sensor has been initialized or not
         Model const * model_;                   ///< Model of the system for which the command and internal dynamics
         std::string name_;                      ///< Name of the sensor
-        vectorN_t data_;                        ///< Measurement buffer to avoid recomputing the same "current" measurement multiple times
+        int32_t kinematicsIdx_;                 ///< Index of the frame of the sensor in the kinematics shared by the sensors of the model, -1 if none
 
     private:
         TelemetrySender telemetrySender_;       ///< Telemetry sender of the sensor used to register and update telemetry variables
@@ -450,8 +563,8 @@ namespace jiminy
         virtual std::vector<std::string> const & getFieldNames(void) const final;
         virtual uint32_t getSize(void) const override final;
 
-        virtual vectorN_t const * get(void) override final;
-        virtual matrixN_t getAll(void) override final;
+        virtual Eigen::Ref<vectorN_t const> get(void) override final;
+        virtual Eigen::Ref<matrixN_t const> getAll(void) override final;
         virtual result_t setAll(float64_t const & t,
                                 vectorN_t const & q,
                                 vectorN_t const & v,
@@ -469,6 +582,10 @@ namespace jiminy
         virtual std::string getTelemetryName(void) const override final;
         using AbstractSensorBase::updateDataBuffer;
         virtual result_t updateDataBuffer(void) override final;
+        /// \brief Update the measurement buffer of some sensors of a delay group, at once.
+        result_t updateDelayGroupData(SensorSharedDataHolder_t::delayGroup_t       & group,
+                                      int32_t                                const * sensorsIdxBegin,
+                                      int32_t                                const * sensorsIdxEnd);
         void clearDataBuffer(void);
 
     public:
@@ -483,7 +600,6 @@ namespace jiminy
         int32_t sensorId_;
 
     private:
-        using AbstractSensorBase::data_;
         SensorSharedDataHolder_t * sharedHolder_;
     };
 }
@@ -43,16 +43,14 @@ namespace jiminy
         // Get an Id
         sensorId_ = sharedHolder_->num_;
 
-        // Add the sensor to the shared data
-        for (matrixN_t & data : sharedHolder_->data_)
-        {
-            data.conservativeResize(Eigen::NoChange, sharedHolder_->num_ + 1);
-        }
+        // Add the sensor to the shared data. The history is meaningless until the next reset.
+        sharedHolder_->resizeDataMeasured(getSize(), sharedHolder_->num_ + 1);
         sharedHolder_->sensors_.push_back(this);
         ++sharedHolder_->num_;
+        clearDataBuffer();
 
         // Initialized the measurement buffer
-        data_ = vectorN_t::Zero(getSize());
+        sharedHolder_->dataMeasured_.col(sensorId_).setZero();
 
         // Update the flag
         isAttached_ = true;
@@ -75,16 +73,10 @@ namespace jiminy
         if(sensorId_ < sharedHolder_->num_ - 1)
         {
             int32_t sensorShift = sharedHolder_->num_ - sensorId_ - 1;
-            for (matrixN_t & data : sharedHolder_->data_)
-            {
-                data.middleCols(sensorId_, sensorShift) =
-                    data.middleCols(sensorId_ + 1, sensorShift).eval();
-            }
-        }
-        for (matrixN_t & data : sharedHolder_->data_)
-        {
-            data.conservativeResize(Eigen::NoChange, sharedHolder_->num_ - 1);
+            sharedHolder_->dataMeasured_.middleCols(sensorId_, sensorShift) =
+                sharedHolder_->dataMeasured_.middleCols(sensorId_ + 1, sensorShift).eval();
         }
+        sharedHolder_->resizeDataMeasured(getSize(), sharedHolder_->num_ - 1);
 
         // Shift the sensor ids
         for (int32_t i = sensorId_ + 1; i < sharedHolder_->num_; i++)
@@ -100,6 +92,11 @@ namespace jiminy
         // Update the total number of sensors left
         --sharedHolder_->num_;
 
+        // The layout of the history has changed, so that it is meaningless until the next reset
+        sharedHolder_->refreshDelayGroups();
+        sharedHolder_->refreshNoiseAndBias(getSize());
+        sharedHolder_->clearHistory(getSize(), sharedHolder_->time_.size());
+
         // Update delayMax_ proxy if necessary
         if (sharedHolder_->delayMax_ < baseSensorOptions_->delay + EPS)
         {
@@ -142,6 +139,8 @@ namespace jiminy
     {
         AbstractSensorBase::setOptions(sensorOptions);
         sharedHolder_->delayMax_ = std::max(sharedHolder_->delayMax_, baseSensorOptions_->delay);
+        sharedHolder_->refreshDelayGroups();
+        sharedHolder_->refreshNoiseAndBias(getSize());
         return result_t::SUCCESS;
     }
 
@@ -198,98 +197,69 @@ namespace jiminy
     }
 
     template <typename T>
-    inline vectorN_t const * AbstractSensorTpl<T>::get(void)
+    inline Eigen::Ref<vectorN_t const> AbstractSensorTpl<T>::get(void)
     {
-        return &data_;
+        return sharedHolder_->dataMeasured_.col(sensorId_);
     }
 
     template <typename T>
-    matrixN_t AbstractSensorTpl<T>::getAll(void)
+    Eigen::Ref<matrixN_t const> AbstractSensorTpl<T>::getAll(void)
     {
-        matrixN_t data(getSize(), sharedHolder_->num_);
-        for (AbstractSensorBase * sensor : sharedHolder_->sensors_)
-        {
-            int32_t const & sensorId = static_cast<AbstractSensorTpl<T> *>(sensor)->sensorId_;
-            data.col(sensorId) = *sensor->get();
-        }
-        return data;
+        return sharedHolder_->dataMeasured_;
     }
 
     template <typename T>
     Eigen::Ref<vectorN_t> AbstractSensorTpl<T>::data(void)
     {
-        return sharedHolder_->data_.back().col(sensorId_);
+        return sharedHolder_->data(sharedHolder_->historySize_ - 1, sensorId_);
     }
 
     template <typename T>
     result_t AbstractSensorTpl<T>::updateDataBuffer(void)
     {
-        // Add 1e-9 to timeDesired to avoid float comparison issues (std::numeric_limits<float64_t>::epsilon() is not enough)
-        float64_t const timeDesired = sharedHolder_->time_.back() - baseSensorOptions_->delay + 1e-9;
-
-        /* Determine the position of the closest right element.
-        Bisection method can be used since times are sorted. */
-        auto bisectLeft =
-            [&](void) -> int32_t
-            {
-                int32_t left = 0;
-                int32_t right = sharedHolder_->time_.size() - 1;
-                int32_t mid = 0;
+        SensorSharedDataHolder_t::delayGroup_t & group =
+            sharedHolder_->delayGroups_[sharedHolder_->sensorsDelayGroupIdx_[sensorId_]];
+        return updateDelayGroupData(group, &sensorId_, &sensorId_ + 1);
+    }
 
-                if (timeDesired >= sharedHolder_->time_.back())
-                {
-                    return right;
-                }
-                else if (timeDesired < sharedHolder_->time_.front())
-                {
-                    return -1;
-                }
+    template <typename T>
+    result_t AbstractSensorTpl<T>::updateDelayGroupData(SensorSharedDataHolder_t::delayGroup_t       & group,
+                                                        int32_t                                const * sensorsIdxBegin,
+                                                        int32_t                                const * sensorsIdxEnd)
+    {
+        SensorSharedDataHolder_t & holder = *sharedHolder_;
+        uint32_t const historySize = holder.historySize_;
 
-                while(left < right)
-                {
-                    mid = (left + right) / 2;
-                    if (timeDesired < sharedHolder_->time_[mid])
-                    {
-                        right = mid;
-                    }
-                    else if (timeDesired > sharedHolder_->time_[mid])
-                    {
-                        left = mid + 1;
-                    }
-                    else
-                    {
-                        return mid;
-                    }
-                }
+        // Add 1e-9 to timeDesired to avoid float comparison issues (std::numeric_limits<float64_t>::epsilon() is not enough)
+        float64_t const timeDesired = holder.time(historySize - 1) - group.delay + 1e-9;
 
-                if (timeDesired < sharedHolder_->time_[mid])
-                {
-                    return mid - 1;
-                }
-                else
-                {
-                    return mid;
-                }
-            };
+        // Determine the position of the closest left element, starting from the previous one
+        int32_t const inputIndexLeft = holder.findDelayedIdx(group, timeDesired);
 
-        int32_t const inputIndexLeft = bisectLeft();
-        data_.setZero();
-        if (timeDesired >= 0.0 && uint32_t(inputIndexLeft + 1) < sharedHolder_->time_.size())
+        if (timeDesired >= 0.0 && uint32_t(inputIndexLeft + 1) < historySize)
         {
             if (inputIndexLeft < 0)
             {
                 std::cout << "Error - AbstractSensorTpl<T>::updateDataBuffer - No data old enough is available." << std::endl;
                 return result_t::ERROR_GENERIC;
             }
-            else if (baseSensorOptions_->delayInterpolationOrder == 0)
+            else if (group.delayInterpolationOrder == 0)
             {
-                data_ = sharedHolder_->data_[inputIndexLeft].col(sensorId_);
+                for (int32_t const * sensorIdx = sensorsIdxBegin; sensorIdx != sensorsIdxEnd; ++sensorIdx)
+                {
+                    holder.dataMeasured_.col(*sensorIdx) = holder.data(inputIndexLeft, *sensorIdx);
+                }
             }
-            else if (baseSensorOptions_->delayInterpolationOrder == 1)
+            else if (group.delayInterpolationOrder == 1)
             {
-                data_ = 1 / (sharedHolder_->time_[inputIndexLeft + 1] - sharedHolder_->time_[inputIndexLeft]) *
-                    ((timeDesired - sharedHolder_->time_[inputIndexLeft]) * sharedHolder_->data_[inputIndexLeft + 1].col(sensorId_) +
-                    (sharedHolder_->time_[inputIndexLeft + 1] - timeDesired) * sharedHolder_->data_[inputIndexLeft].col(sensorId_));
+                float64_t const & timeLeft = holder.time(inputIndexLeft);
+                float64_t const & timeRight = holder.time(inputIndexLeft + 1);
+                float64_t const ratio = (timeDesired - timeLeft) / (timeRight - timeLeft);
+                for (int32_t const * sensorIdx = sensorsIdxBegin; sensorIdx != sensorsIdxEnd; ++sensorIdx)
+                {
+                    holder.dataMeasured_.col(*sensorIdx) = ratio * holder.data(inputIndexLeft + 1, *sensorIdx) +
+                        (1.0 - ratio) * holder.data(inputIndexLeft, *sensorIdx);
+                }
             }
             else
             {
@@ -299,16 +269,17 @@ namespace jiminy
         }
         else
         {
-            if (sharedHolder_->time_[0] >= 0.0
-            || baseSensorOptions_->delay < std::numeric_limits<float64_t>::epsilon())
+            /* Return the most recent value, or Zero if the sensor is not fully
+               initialized yet, which is the value of the oldest sample. */
+            uint32_t inputIndex = 0;
+            if (holder.time(0) >= 0.0
+            || group.delay < std::numeric_limits<float64_t>::epsilon())
             {
-                // Return the most recent value
-                data_ = sharedHolder_->data_.back().col(sensorId_);
+                inputIndex = historySize - 1;
             }
-            else
+            for (int32_t const * sensorIdx = sensorsIdxBegin; sensorIdx != sensorsIdxEnd; ++sensorIdx)
             {
-                // Return Zero since the sensor is not fully initialized yet
-                data_ = sharedHolder_->data_.front().col(sensorId_);
+                holder.dataMeasured_.col(*sensorIdx) = holder.data(inputIndex, *sensorIdx);
             }
         }
 
@@ -318,15 +289,15 @@ namespace jiminy
     template <typename T>
     void AbstractSensorTpl<T>::clearDataBuffer(void)
     {
-        sharedHolder_->time_.resize(2);
-        std::fill(sharedHolder_->time_.begin(), sharedHolder_->time_.end(), -1);
-        sharedHolder_->time_.back() = 0;
-        sharedHolder_->data_.resize(2);
-        for (matrixN_t & data : sharedHolder_->data_)
-        {
-            data = matrixN_t::Zero(getSize(), sharedHolder_->num_); // Do not use setZero since the size may be ill-defined
-        }
-        data_.setZero();
+        /* Preallocate enough samples to cover the maximum delay at the maximum time step.
+           The ring buffers are never shrunk, so that they keep the capacity reached during
+           the previous simulations, and do not have to grow anymore if the time step is smaller. */
+        uint32_t const capacityMin = 2U + MIN_DELAY_BUFFER_RESERVE + static_cast<uint32_t>(
+            std::ceil((sharedHolder_->delayMax_ + MAX_SIMULATION_TIMESTEP) / MAX_SIMULATION_TIMESTEP));
+        sharedHolder_->refreshDelayGroups();
+        sharedHolder_->refreshNoiseAndBias(getSize());
+        sharedHolder_->clearHistory(getSize(), capacityMin);
+        sharedHolder_->dataMeasured_.col(sensorId_).setZero();
     }
 
     template <typename T>
@@ -343,82 +314,67 @@ namespace jiminy
         float64_t const timeMin = t - sharedHolder_->delayMax_ - MAX_SIMULATION_TIMESTEP;
 
         // Internal buffer memory management
-        if (t + std::numeric_limits<float64_t>::epsilon() > sharedHolder_->time_.back())
+        SensorSharedDataHolder_t & holder = *sharedHolder_;
+        if (t + std::numeric_limits<float64_t>::epsilon() > holder.time(holder.historySize_ - 1))
         {
-            if (sharedHolder_->time_[0] < 0 || timeMin > sharedHolder_->time_[1])
+            // Drop the initial sample, then the ones that are too old to be used anymore
+            if (holder.time(0) < 0 || timeMin > holder.time(1))
             {
-                // Remove some unecessary extra elements if appropriate
-                if (sharedHolder_->time_.size() > 2 + MAX_DELAY_BUFFER_EXCEED
-                && timeMin > sharedHolder_->time_[2 + MAX_DELAY_BUFFER_EXCEED])
-                {
-                    for (uint8_t i=0; i < 1 + MAX_DELAY_BUFFER_EXCEED; i ++)
-                    {
-                        sharedHolder_->time_.pop_front();
-                        sharedHolder_->data_.pop_front();
-                    }
-
-                    sharedHolder_->time_.rset_capacity(sharedHolder_->time_.size() + MIN_DELAY_BUFFER_RESERVE);
-                    sharedHolder_->data_.rset_capacity(sharedHolder_->data_.size() + MIN_DELAY_BUFFER_RESERVE);
-                }
-
-                // Rotate the internal buffer
-                sharedHolder_->time_.rotate(sharedHolder_->time_.begin() + 1);
-                sharedHolder_->data_.rotate(sharedHolder_->data_.begin() + 1);
+                holder.popFrontHistory();
             }
-            else
+            while (holder.historySize_ > 2 && timeMin > holder.time(1))
             {
-                // Increase capacity if required
-                if(sharedHolder_->time_.full())
-                {
-                    sharedHolder_->time_.rset_capacity(sharedHolder_->time_.size() + 1 + MIN_DELAY_BUFFER_RESERVE);
-                    sharedHolder_->data_.rset_capacity(sharedHolder_->data_.size() + 1 + MIN_DELAY_BUFFER_RESERVE);
-                }
-
-                // Push back new empty buffer (Do NOT initialize it for efficiency)
-                sharedHolder_->time_.push_back();
-                sharedHolder_->data_.push_back();
-                sharedHolder_->data_.back().resize(getSize(), sharedHolder_->num_);
+                holder.popFrontHistory();
             }
+
+            // Append a new sample (Do NOT initialize it for efficiency)
+            holder.pushBackHistory();
         }
         else
         {
             /* Remove the extra last elements if for some reason the solver went back in time.
                 It happens when an iteration fails using ode solvers relying on try_step mechanism. */
-            while(t + std::numeric_limits<float64_t>::epsilon() < sharedHolder_->time_.back()
-            && sharedHolder_->time_.size() > 2)
+            while(t + std::numeric_limits<float64_t>::epsilon() < holder.time(holder.historySize_ - 1)
+            && holder.historySize_ > 2)
             {
-                sharedHolder_->time_.pop_back();
-                sharedHolder_->data_.pop_back();
+                holder.popBackHistory();
             }
         }
-        sharedHolder_->time_.back() = t;
+        holder.time(holder.historySize_ - 1) = t;
 
-        // Compute the sensors' output
+        // Compute the true value of the sensors' output
         for (AbstractSensorBase * sensor : sharedHolder_->sensors_)
         {
             if (returnCode == result_t::SUCCESS)
             {
-                // Compute the true value
                 returnCode = sensor->set(t, q, v, a, u);
             }
+        }
 
-            if (returnCode == result_t::SUCCESS)
+        // Add the white noise and the bias of every sensor at once
+        if (returnCode == result_t::SUCCESS && (holder.hasNoise_ || holder.hasBias_))
+        {
+            auto dataLast = holder.data_.middleCols(
+                holder.getHistoryIdx(holder.historySize_ - 1) * holder.num_, holder.num_);
+            if (holder.hasNoise_)
             {
-                // Add white noise
-                if (baseSensorOptions_->noiseStd.size())
-                {
-                    data(sensor) += randVectorNormal(sensor->baseSensorOptions_->noiseStd);
-                }
-                if (sensor->baseSensorOptions_->bias.size())
-                {
-                    data(sensor) += sensor->baseSensorOptions_->bias;
-                }
+                randMatrixNormal(holder.noise_);
+                dataLast.array() += holder.noiseStd_.array() * holder.noise_.array() + holder.bias_.array();
+            }
+            else
+            {
+                dataLast += holder.bias_;
             }
+        }
 
+        // Update the data buffer of the sensors sharing the same delay at once
+        for (SensorSharedDataHolder_t::delayGroup_t & group : holder.delayGroups_)
+        {
             if (returnCode == result_t::SUCCESS)
             {
-                // Update data buffer
-                returnCode = updateDataBuffer(sensor);
+                returnCode = updateDelayGroupData(group,
+                                                  group.sensorsIdx.data(),
+                                                  group.sensorsIdx.data() + group.sensorsIdx.size());
             }
         }
 
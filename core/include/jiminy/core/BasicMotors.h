@@ -59,6 +59,11 @@ namespace jiminy
 
         virtual result_t setOptions(configHolder_t motorOptions);
 
+    protected:
+        virtual void refreshBank(MotorSharedDataHolder_t::motorBank_t & bank) const override;
+        virtual result_t computeEffortBank(float64_t                            const & t,
+                                           MotorSharedDataHolder_t::motorBank_t       & bank) override;
+
     private:
         virtual result_t computeEffort(float64_t const & t,
                                        float64_t const & q,
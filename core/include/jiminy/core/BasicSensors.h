@@ -20,6 +20,9 @@ namespace jiminy
 
         std::string const & getFrameName(void) const;
 
+    protected:
+        virtual int32_t getKinematicsFrameIdx(void) const override;
+
     private:
         virtual result_t set(float64_t const & t,
                              vectorN_t const & q,
@@ -54,6 +57,7 @@ namespace jiminy
     private:
         std::string frameName_;
         int32_t frameIdx_;
+        int32_t contactIdx_;    ///< Index of the frame in the contact points of the model, -1 if it is not one of them
     };
 
     class EncoderSensor : public AbstractSensorTpl<EncoderSensor>
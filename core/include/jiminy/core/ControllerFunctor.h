@@ -69,6 +69,18 @@ namespace jiminy
         ///////////////////////////////////////////////////////////////////////////////////////////////
         virtual result_t initialize(std::shared_ptr<Model const> const & model) override;
 
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        ///
+        /// \brief      Reset the internal state of the controller.
+        ///
+        /// \details    The proxies to the sensor data are refreshed, since they are invalidated
+        ///             every time a sensor is attached or detached.
+        ///
+        /// \param[in]  resetDynamicTelemetry  Whether or not to reset the telemetry of dynamically registered variables.
+        ///
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        virtual void reset(bool_t const & resetDynamicTelemetry = false) override;
+
         ///////////////////////////////////////////////////////////////////////////////////////////////
         ///
         /// \brief      Compute the command.
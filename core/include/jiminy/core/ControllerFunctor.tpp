@@ -34,6 +34,16 @@ namespace jiminy
         return AbstractController::initialize(model);
     }
 
+    template<typename F1, typename F2>
+    void ControllerFunctor<F1, F2>::reset(bool_t const & resetDynamicTelemetry)
+    {
+        AbstractController::reset(resetDynamicTelemetry);
+        if (getIsInitialized())
+        {
+            sensorsData_ = model_->getSensorsData();
+        }
+    }
+
     template<typename F1, typename F2>
     result_t ControllerFunctor<F1, F2>::computeCommand(float64_t const & t,
                                                        vectorN_t const & q,
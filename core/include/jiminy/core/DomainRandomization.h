@@ -0,0 +1,62 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief       Per-episode randomization of the contact and motor parameters.
+///
+/// \details     The distributions are specified once, then a new set of scale
+///              factors is sampled every time a simulation starts and applied
+///              directly on the nominal parameters of the engine, without going
+///              through the options. The dynamics of the bodies is randomized
+///              by the model itself, see the bias options of the model.
+///
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef JIMINY_DOMAIN_RANDOMIZATION_H
+#define JIMINY_DOMAIN_RANDOMIZATION_H
+
+#include "jiminy/core/Types.h"
+
+
+namespace jiminy
+{
+    enum class randomizedParameter_t : uint32_t
+    {
+        CONTACT_FRICTION_VISCOUS = 0,
+        CONTACT_FRICTION_DRY = 1,
+        CONTACT_STIFFNESS = 2,
+        CONTACT_DAMPING = 3,
+        MOTORS_TORQUE_LIMIT = 4,
+        MOTORS_ROTOR_INERTIA = 5
+    };
+
+    class DomainRandomization
+    {
+    public:
+        // Disable the copy of the class
+        DomainRandomization(DomainRandomization const & domainRandomization) = delete;
+        DomainRandomization & operator = (DomainRandomization const & other) = delete;
+
+    public:
+        DomainRandomization(void);
+        ~DomainRandomization(void) = default;
+
+        /// \brief Randomize a parameter by a scale factor uniformly distributed in [scaleMin, scaleMax].
+        ///
+        /// \details The same scale factor is applied to every contact point or every motor.
+        result_t addParameter(randomizedParameter_t const & parameter,
+                              float64_t             const & scaleMin,
+                              float64_t             const & scaleMax);
+        void clear(void);
+
+        /// \brief Sample a set of scale factors, in the order the parameters have been added.
+        void sample(vectorN_t & scales) const;
+
+        std::vector<randomizedParameter_t> const & getParameters(void) const;
+        uint32_t getNumParameters(void) const;
+
+    private:
+        std::vector<randomizedParameter_t> parameters_;
+        std::vector<std::pair<float64_t, float64_t> > scalesBounds_;
+    };
+}
+
+#endif //end of JIMINY_DOMAIN_RANDOMIZATION_H
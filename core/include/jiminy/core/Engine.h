@@ -14,6 +14,8 @@
 #include "jiminy/core/Utilities.h"
 #include "jiminy/core/Model.h"
 #include "jiminy/core/TelemetrySender.h"
+#include "jiminy/core/TerminationConditions.h"
+#include "jiminy/core/DomainRandomization.h"
 #include "jiminy/core/Types.h"
 
 #include <boost/numeric/odeint.hpp>
@@ -32,6 +34,7 @@ namespace jiminy
     class AbstractController;
     class TelemetryData;
     class TelemetryRecorder;
+    class TelemetryDataset;
 
     class explicit_euler
     {
@@ -63,6 +66,132 @@ namespace jiminy
         }
     };
 
+    ///////////////////////////////////////////////////////////////////////////////
+    /// \brief      Explicit Runge-Kutta stepper on the configuration manifold.
+    ///
+    /// \details    The stages are computed in the tangent space [v, a] of the state,
+    ///             and the configuration is advanced from the beginning of the step
+    ///             using pinocchio::integrate, as Runge-Kutta-Munthe-Kaas methods. The
+    ///             velocity of the stages is mapped through the inverse differential of
+    ///             the exponential map of the joints, truncated after the second order
+    ///             bracket which is enough up to order 5. Thus the quaternions stay on
+    ///             the unit sphere by construction, without loss of accuracy. The step is
+    ///             adapted based on the embedded error estimate if any, measured in
+    ///             tangent coordinates. Like the controlled steppers of odeint, the
+    ///             derivative dxdt must be the one of the state at the beginning of the
+    ///             step, and it is updated on success.
+    ///////////////////////////////////////////////////////////////////////////////
+    class runge_kutta_lie
+    {
+    public:
+        using state_type = vectorN_t;
+        using deriv_type = vectorN_t;
+        using value_type = float64_t;
+        using time_type = float64_t;
+        using order_type = unsigned short;
+
+        using stepper_category = controlled_stepper_tag;
+
+    public:
+        runge_kutta_lie(pinocchio::Model const & model,
+                        matrixN_t        const & A,
+                        vectorN_t        const & b,
+                        vectorN_t        const & c,
+                        vectorN_t        const & bError,
+                        order_type       const & order,
+                        float64_t        const & tolAbs,
+                        float64_t        const & tolRel);
+
+        /// \brief Dormand-Prince 5(4) scheme, with adaptive step.
+        static runge_kutta_lie dopri5(pinocchio::Model const & model,
+                                      float64_t        const & tolAbs,
+                                      float64_t        const & tolRel);
+
+        /// \brief Classic Runge-Kutta 4 scheme, with fixed step.
+        static runge_kutta_lie rk4(pinocchio::Model const & model);
+
+        order_type order(void) const;
+
+        template<class System>
+        controlled_step_result try_step(System       system,
+                                        state_type & x,
+                                        deriv_type & dxdt,
+                                        time_type  & t,
+                                        time_type  & dt)
+        {
+            uint32_t const nStages = c_.size();
+
+            // The derivative of the first stage is the one at the beginning of the step
+            setStageDerivative(0, x, dxdt);
+
+            for (uint32_t i = 1; i < nStages; i++)
+            {
+                dxStep_.noalias() = dt * K_.leftCols(i) * A_.row(i).head(i).transpose();
+                integrate(x, dxStep_, xStage_);
+                system(xStage_, dxdtStage_, t + c_[i] * dt);
+                setStageDerivative(i, xStage_, dxdtStage_);
+                correctStageDerivative(i, dxStep_);
+            }
+
+            // Reject the step if the estimated error is too large, and adapt the step
+            dxStep_.noalias() = dt * K_ * b_;
+            if (bError_.size() > 0)
+            {
+                dxError_.noalias() = dt * K_ * bError_;
+                if (!adaptStep(x, t, dt))
+                {
+                    return controlled_step_result::fail;
+                }
+            }
+            else
+            {
+                t += dt;
+            }
+
+            /* Update the state and its derivative. They have already been computed by the
+               last stage if it is evaluated at the end of the step (first-same-as-last). */
+            if (!isFsal_)
+            {
+                integrate(x, dxStep_, xStage_);
+                system(xStage_, dxdtStage_, t);
+            }
+            x = xStage_;
+            dxdt = dxdtStage_;
+
+            return controlled_step_result::success;
+        }
+
+    private:
+        void integrate(state_type const & x,
+                       vectorN_t  const & dx,
+                       state_type       & xNext) const;
+        void setStageDerivative(uint32_t   const & stageIdx,
+                                state_type const & x,
+                                deriv_type const & dxdt);
+        void correctStageDerivative(uint32_t  const & stageIdx,
+                                    vectorN_t const & dx);
+        bool_t adaptStep(state_type const & x,
+                         time_type        & t,
+                         time_type        & dt) const;
+
+    private:
+        pinocchio::Model const * model_;
+        matrixN_t A_;
+        vectorN_t b_;
+        vectorN_t c_;
+        vectorN_t bError_;
+        order_type order_;
+        float64_t tolAbs_;
+        float64_t tolRel_;
+        bool_t isFsal_;         ///< Whether the last stage is evaluated at the end of the step
+        std::vector<std::pair<int32_t, joint_t> > lieJoints_;   ///< Velocity index and type of the joints that are not Euclidean
+        matrixN_t K_;           ///< Derivative of each stage in tangent space, one column per stage
+        vectorN_t dxStep_;      ///< Increment of the state in tangent space
+        vectorN_t dxError_;     ///< Error estimate of the increment in tangent space
+        state_type xStage_;
+        deriv_type dxdtStage_;
+    };
+
     struct stepperState_t
     {
     public:
@@ -166,6 +295,48 @@ namespace jiminy
         bool_t isInitialized_;
     };
 
+    struct forceImpulse_t
+    {
+        std::string frameName;
+        int32_t frameIdx;       ///< Index of the frame, resolved when the simulation starts
+        float64_t t;            ///< Application time
+        float64_t dt;           ///< Duration
+        vector3_t F;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////
+    /// \brief      Piecewise-polynomial force profile, evaluated natively.
+    ///
+    /// \details    On the interval [t_k, t_{k+1}[, the force is given by
+    ///             F(t) = sum_j c_{k,j} (t - t_k)^j. It is zero outside of the
+    ///             breakpoints. The interval of the previous evaluation is kept in
+    ///             memory, since the time is almost always increasing.
+    ///////////////////////////////////////////////////////////////////////////////
+    struct forceProfilePolynomial_t
+    {
+    public:
+        forceProfilePolynomial_t(void);
+
+        /// \param[in] frameName       Name of the frame on which the force is applied.
+        /// \param[in] breakpoints     Breakpoints t_k, strictly increasing, of size m+1.
+        /// \param[in] coefficients    Coefficients c_{k,j} stored in column k*(order+1)+j, of size (3, m*(order+1)).
+        result_t initialize(std::string const & frameName,
+                            vectorN_t   const & breakpoints,
+                            matrixN_t   const & coefficients);
+
+        vector3_t operator()(float64_t const & t);
+
+    public:
+        std::string frameName;
+        int32_t frameIdx;
+
+    private:
+        vectorN_t breakpoints_;
+        matrixN_t coefficients_;
+        uint32_t order_;
+        uint32_t intervalIdx_;      ///< Index of the interval of the previous evaluation
+    };
+
     class Engine
     {
     public:
@@ -177,7 +348,7 @@ namespace jiminy
 
     protected:
         using rungeKuttaStepper_t = runge_kutta_dopri5<vectorN_t, float64_t, vectorN_t, float64_t, vector_space_algebra>;
-        using stepper_t = boost::variant<result_of::make_controlled<rungeKuttaStepper_t>::type, explicit_euler>;
+        using stepper_t = boost::variant<result_of::make_controlled<rungeKuttaStepper_t>::type, explicit_euler, runge_kutta_lie>;
 
     public:
         // Disable the copy of the class
@@ -275,7 +446,7 @@ namespace jiminy
             configHolder_t config;
             config["verbose"] = false;
             config["randomSeed"] = 0U;
-            config["odeSolver"] = std::string("runge_kutta_dopri5"); // ["runge_kutta_dopri5", "explicit_euler"]
+            config["odeSolver"] = std::string("runge_kutta_dopri5"); // ["runge_kutta_dopri5", "explicit_euler", "runge_kutta_dopri5_lie", "runge_kutta_4_lie"]
             config["tolAbs"] = 1.0e-5;
             config["tolRel"] = 1.0e-4;
             config["dtMax"] = 1.0e-3;
@@ -438,12 +609,55 @@ namespace jiminy
                           vectorN_t const & xInit,
                           bool_t    const & isStateTheoretical = false);
 
+        /// \brief Add a native condition to stop the simulation.
+        ///
+        /// \details The stop conditions are checked by 'simulate' before every step, in
+        ///          addition to the callback, without any round trip to the caller. They
+        ///          are resolved for the current model when the simulation starts. They
+        ///          are not checked by 'step', the caller being in charge of terminating
+        ///          the simulation, for instance through an Environment. The engine keeps
+        ///          its own copy of the condition, so that it may be shared between engines.
+        result_t addStopCondition(std::shared_ptr<AbstractTerminationCondition> const & condition);
+        void removeStopConditions(void);
+
+        /// \brief Randomize the contact and motor parameters every time the simulation starts.
+        ///
+        /// \details A new set of parameters is sampled after the reset of the random number
+        ///          generators, unless it has been specified beforehand. Set to nullptr to
+        ///          disable the randomization.
+        result_t setDomainRandomization(std::shared_ptr<DomainRandomization const> const & domainRandomization);
+        /// \brief Specify the scale factors to apply at the next start instead of sampling them.
+        result_t setDomainRandomizationScales(vectorN_t const & scales);
+        /// \brief Select the sequence of random numbers of the engine for a given seed.
+        ///
+        /// \details Every engine owns its own random number generators, seeded by both the
+        ///          random seed of the stepper and this index. Engines running concurrently
+        ///          must use different indices to get independent random numbers. The
+        ///          generators are reset right away.
+        result_t setRandomStreamIdx(uint32_t const & streamIdx);
+
         result_t registerForceImpulse(std::string const & frameName,
                                       float64_t   const & t,
                                       float64_t   const & dt,
                                       vector3_t   const & F);
         result_t registerForceProfile(std::string      const & frameName,
                                       forceFunctor_t           forceFct);
+        /// \brief Register a force profile linearly interpolated between samples.
+        ///
+        /// \param[in] frameName   Name of the frame on which the force is applied.
+        /// \param[in] t           Sampling times, strictly increasing.
+        /// \param[in] F           Sampled forces, one row per sampling time.
+        result_t registerForceProfileTabulated(std::string const & frameName,
+                                               vectorN_t   const & t,
+                                               matrixN_t   const & F);
+        /// \brief Register a piecewise-polynomial force profile.
+        ///
+        /// \param[in] frameName       Name of the frame on which the force is applied.
+        /// \param[in] breakpoints     Breakpoints, strictly increasing, of size m+1.
+        /// \param[in] coefficients    Coefficients of every interval by increasing power, of size (m*(order+1), 3).
+        result_t registerForceProfilePolynomial(std::string const & frameName,
+                                                vectorN_t   const & breakpoints,
+                                                matrixN_t   const & coefficients);
 
         configHolder_t const & getOptions(void) const;
         result_t setOptions(configHolder_t const & engineOptions);
@@ -459,6 +673,17 @@ namespace jiminy
                            std::vector<std::vector<int32_t> >   & intData,
                            std::vector<std::vector<float32_t> > & floatData);
 
+        /// \brief Get the full logged content, column by column.
+        ///
+        /// \param[out] header      Header, vector of field names.
+        /// \param[out] timestamps  Global.Time, in seconds.
+        /// \param[out] intData     Integer data, one column per variable.
+        /// \param[out] floatData   Float data, one column per variable.
+        void getLogDataColumns(std::vector<std::string> & header,
+                               vectorN_t                & timestamps,
+                               intDataMatrix_t          & intData,
+                               floatDataMatrix_t        & floatData);
+
         /// \brief Get the full logged content.
         ///
         /// \param[out] header      Header, vector of field names.
@@ -480,11 +705,21 @@ namespace jiminy
         result_t writeLogTxt(std::string const & filename);
         result_t writeLogBinary(std::string const & filename);
 
+        /// \brief Append the current log as a new episode of a dataset.
+        ///
+        /// \param[in] dataset      Dataset opened in writing mode.
+        result_t writeLogDataset(TelemetryDataset & dataset);
+
         static result_t parseLogBinaryRaw(std::string                          const & filename,
                                           std::vector<std::string>                   & header,
                                           std::vector<float64_t>                     & timestamps,
                                           std::vector<std::vector<int32_t> >         & intData,
                                           std::vector<std::vector<float32_t> >       & floatData);
+        static result_t parseLogBinaryColumns(std::string              const & filename,
+                                              std::vector<std::string>       & header,
+                                              vectorN_t                      & timestamps,
+                                              intDataMatrix_t                & intData,
+                                              floatDataMatrix_t              & floatData);
         static result_t parseLogBinary(std::string              const & filename,
                                        std::vector<std::string>       & header,
                                        matrixN_t                      & logData);
@@ -517,6 +752,7 @@ namespace jiminy
     private:
         void reset(bool_t const & resetRandomNumbers,
                    bool_t const & resetDynamicForceRegister);
+        void applyDomainRandomization(vectorN_t const & scales);
 
         template<typename Scalar, int Options, template<typename, int> class JointCollectionTpl,
                  typename ConfigVectorType, typename TangentVectorType>
@@ -557,8 +793,18 @@ namespace jiminy
         std::shared_ptr<AbstractController> controller_;
         configHolder_t engineOptionsHolder_;
         callbackFunctor_t callbackFct_;
+        std::vector<std::shared_ptr<AbstractTerminationCondition> > stopConditions_;
+        std::shared_ptr<DomainRandomization const> domainRandomization_;
 
     private:
+        struct contactParameters_t
+        {
+            float64_t frictionViscous;
+            float64_t frictionDry;
+            float64_t stiffness;
+            float64_t damping;
+        };
+
         std::unique_ptr<MutexLocal::LockGuardLocal> lockModel_;
         TelemetrySender telemetrySender_;
         std::shared_ptr<TelemetryData> telemetryData_;
@@ -567,9 +813,22 @@ namespace jiminy
         float64_t stepperUpdatePeriod_;
         stepperState_t stepperState_;       ///< Internal buffer with the state for the integration loop
         stepperState_t stepperStateLast_;   ///< Internal state for the integration loop at the end of the previous iteration
-        std::map<float64_t, std::tuple<std::string, float64_t, vector3_t> > forcesImpulse_; // Note that one MUST use an ordered map wrt. the application time
-        std::map<float64_t, std::tuple<std::string, float64_t, vector3_t> >::const_iterator forceImpulseNextIt_;
+        std::vector<forceImpulse_t> forcesImpulse_;         ///< Impulse forces, sorted by application time. They may overlap.
+        uint32_t forceImpulseNextIdx_;                      ///< Index of the next impulse force to activate
+        std::vector<uint32_t> forcesImpulseActive_;         ///< Indices of the impulse forces currently active
         std::vector<std::pair<std::string, std::tuple<int32_t, forceFunctor_t> > > forcesProfile_;
+        std::vector<forceProfilePolynomial_t> forcesProfilePolynomial_;
+        contactParameters_t contactParameters_;             ///< Contact parameters of the current simulation, possibly randomized
+        vectorN_t domainRandomizationScales_;               ///< Scale factors specified for the next start, if any
+        randomGeneratorState_t randomGeneratorState_;       ///< Random number generators, used while the engine is running
+        uint32_t randomStreamIdx_;                          ///< Index of the sequence of random numbers for the current seed
+        std::vector<int32_t> jointsLimitsPositionIdx_;      ///< Position indices of the DOFs of the rigid joints subject to limits
+        std::vector<int32_t> jointsLimitsVelocityIdx_;      ///< Velocity indices of the DOFs of the rigid joints subject to limits
+        vectorN_t jointsLimitsPosition_;                    ///< Buffer with the position of the DOFs subject to limits
+        vectorN_t jointsLimitsVelocity_;                    ///< Buffer with the velocity of the DOFs subject to limits
+        vectorN_t jointsLimitsError_;                       ///< Buffer with the signed violation of the current limit
+        vectorN_t jointsLimitsForce_;                       ///< Buffer with the penalty force of the current limit
+        vectorN_t jointsLimitsTotalForce_;                  ///< Buffer with the total penalty force of the limits
     };
 }
 
@@ -0,0 +1,153 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief       Declaration of the EngineBatch class, responsible of stepping
+///              several independent engines at once.
+///
+/// \details     Every engine of the batch is driven by a native controller
+///              applying the command provided for this engine, so that the
+///              whole batch can be stepped by a pool of worker threads
+///              without any round trip to the caller. It is intended for
+///              learning environments, for which the same model is simulated
+///              many times in parallel.
+///
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef JIMINY_ENGINE_BATCH_H
+#define JIMINY_ENGINE_BATCH_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "jiminy/core/Engine.h"
+#include "jiminy/core/Types.h"
+
+
+namespace jiminy
+{
+    class EngineBatch
+    {
+    public:
+        /// Layout of the batch buffers, one row per engine, compatible with
+        /// C-contiguous numpy arrays of shape (N, ...).
+        using batchMatrix_t = Eigen::Matrix<float64_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+    public:
+        // Disable the copy of the class
+        EngineBatch(EngineBatch const & engineBatch) = delete;
+        EngineBatch & operator = (EngineBatch const & other) = delete;
+
+    public:
+        EngineBatch(void);
+        ~EngineBatch(void);
+
+        /// \brief Create one engine per model.
+        ///
+        /// \details The models must be distinct instances of the same robot, since
+        ///          each of them is locked by its own engine during the simulation.
+        ///
+        /// \param[in] models       Initialized models, with sensors and motors attached.
+        /// \param[in] numThreads   Number of worker threads. 0 to use the number of cores.
+        result_t initialize(std::vector<std::shared_ptr<Model> > const & models,
+                            uint32_t                             const & numThreads = 0U);
+
+        /// \brief Start the simulation of every engine.
+        ///
+        /// \param[in] xInit                Initial states, one row per engine.
+        /// \param[in] isStateTheoretical   Specify if the initial states are associated with the current or theoretical models.
+        /// \param[in] resetRandomNumbers   Whether or not to reset the random number generators.
+        result_t start(Eigen::Ref<batchMatrix_t const> const & xInit,
+                       bool_t                          const & isStateTheoretical = false,
+                       bool_t                          const & resetRandomNumbers = false);
+
+        /// \brief Apply the commands and integrate every engine for a duration equal to stepSize.
+        ///
+        /// \details The states and the sensors data at the end of the step are written
+        ///          in place. The sensors data of an engine are stored contiguously, sorted
+        ///          by sensor type name, then by sensor index. The output buffers are
+        ///          ignored if empty.
+        ///
+        /// \param[in]  uCommand        Motor commands, one row per engine.
+        /// \param[in]  stepSize        Duration of the step ; set to negative value to use default update value.
+        /// \param[out] x               States of the engines, of size (N, nx).
+        /// \param[out] sensorsData     Sensors data of the engines, of size (N, getSensorsDataSize()).
+        result_t step(Eigen::Ref<batchMatrix_t const> const & uCommand,
+                      float64_t                       const & stepSize,
+                      Eigen::Ref<batchMatrix_t>               x,
+                      Eigen::Ref<batchMatrix_t>               sensorsData);
+
+        /// \brief Integrate every engine for several consecutive steps of duration stepSize.
+        ///
+        /// \details The commands are either held for every step, or provided for each of
+        ///          them, stacked along the columns. Likewise, the timestamps, the states
+        ///          and the sensors data at the end of every step are stacked along the
+        ///          columns of the output buffers, which corresponds to C-contiguous numpy
+        ///          arrays of shape (N, numSteps, ...). The output buffers are ignored if empty.
+        ///
+        /// \param[in]  uCommand        Motor commands, of size (N, nu) or (N, numSteps * nu).
+        /// \param[in]  numSteps        Number of steps to perform.
+        /// \param[in]  stepSize        Duration of each step ; set to negative value to use default update value.
+        /// \param[out] t               Time at the end of each step, of size (N, numSteps).
+        /// \param[out] x               States of the engines, of size (N, numSteps * nx).
+        /// \param[out] sensorsData     Sensors data of the engines, of size (N, numSteps * getSensorsDataSize()).
+        result_t stepMultiple(Eigen::Ref<batchMatrix_t const> const & uCommand,
+                              uint32_t                        const & numSteps,
+                              float64_t                       const & stepSize,
+                              Eigen::Ref<batchMatrix_t>               t,
+                              Eigen::Ref<batchMatrix_t>               x,
+                              Eigen::Ref<batchMatrix_t>               sensorsData);
+
+        /// \brief Stop the simulation of every engine.
+        void stop(void);
+
+        /// \brief Randomize the contact and motor parameters of every engine when the simulation starts.
+        ///
+        /// \details Every engine samples its parameters from its own random number generators,
+        ///          so they are the same as if the engine was started alone. Set to nullptr
+        ///          to disable the randomization.
+        result_t setDomainRandomization(std::shared_ptr<DomainRandomization const> const & domainRandomization);
+
+        bool_t getIsInitialized(void) const;
+        uint32_t size(void) const;
+        Engine & getEngine(uint32_t const & idx) const;
+        uint32_t const & nx(void) const;
+        uint32_t const & nu(void) const;
+        uint32_t const & getSensorsDataSize(void) const;
+
+    private:
+        /// \brief Run a job for every engine using the worker threads.
+        ///
+        /// \details The engines are evenly split between the workers once and for all,
+        ///          so that a given engine is always handled by the same thread. It
+        ///          guarantees that the random numbers are reproducible.
+        ///
+        /// \return SUCCESS if the job succeeded for every engine, the first error otherwise.
+        result_t runJob(std::function<result_t(uint32_t const & /*idx*/)> const & job);
+        void workerLoop(uint32_t const & workerIdx);
+        void stopWorkers(void);
+        void getSensorsData(uint32_t const & idx,
+                            float64_t      * sensorsData) const;
+
+    private:
+        bool_t isInitialized_;
+        uint32_t nx_;
+        uint32_t nu_;
+        uint32_t sensorsDataSize_;
+        std::vector<std::shared_ptr<Engine> > engines_;
+        std::vector<vectorN_t> commands_;                           ///< Command applied by the controller of each engine.
+        std::vector<vectorN_t const *> sensorsData_;                ///< Flat sensors data of each engine.
+
+        std::vector<std::thread> workers_;
+        std::mutex workersMutex_;
+        std::condition_variable jobCondition_;                      ///< Notify the workers that a new job is available.
+        std::condition_variable doneCondition_;                     ///< Notify that every worker is done.
+        std::function<result_t(uint32_t const &)> const * job_;    ///< Job currently processed by the workers.
+        uint64_t jobCounter_;                                       ///< Index of the current job.
+        uint32_t numWorkersBusy_;
+        bool_t isStopping_;
+        std::vector<result_t> jobResults_;                          ///< Result of the current job for each worker.
+    };
+}
+
+#endif //end of JIMINY_ENGINE_BATCH_H
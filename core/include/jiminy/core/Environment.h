@@ -0,0 +1,189 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief       Declaration of the Environment class, providing the observation,
+///              the reward and the termination of a learning environment on top
+///              of an Engine.
+///
+/// \details     The observation is assembled from slices of the state and from
+///              the data of sensor groups, flattened into a single vector. The
+///              reward is a weighted sum of reward terms, and the episode is over
+///              as soon as one of the termination conditions is triggered.
+///              Everything is computed natively, so that it can be used by any
+///              learning framework, without going through Python at every step.
+///
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef JIMINY_ENVIRONMENT_H
+#define JIMINY_ENVIRONMENT_H
+
+#include "jiminy/core/Engine.h"
+#include "jiminy/core/TerminationConditions.h"
+#include "jiminy/core/Types.h"
+
+
+namespace jiminy
+{
+    class AbstractRewardTerm
+    {
+    public:
+        // Disable the copy of the class
+        AbstractRewardTerm(AbstractRewardTerm const & rewardTerm) = delete;
+        AbstractRewardTerm & operator = (AbstractRewardTerm const & other) = delete;
+
+    public:
+        AbstractRewardTerm(void) = default;
+        virtual ~AbstractRewardTerm(void) = default;
+
+        ///////////////////////////////////////////////////////////////////////////////
+        /// \brief      Resolve everything that depends on the model.
+        ///////////////////////////////////////////////////////////////////////////////
+        virtual result_t initialize(Model const & model);
+
+        ///////////////////////////////////////////////////////////////////////////////
+        /// \brief      Compute the reward over the last step.
+        ///
+        /// \param[in]  model           Model of the system.
+        /// \param[in]  stepperState    State of the stepper at the end of the step.
+        /// \param[in]  dt              Duration of the step.
+        ///////////////////////////////////////////////////////////////////////////////
+        virtual float64_t compute(Model          const & model,
+                                  stepperState_t const & stepperState,
+                                  float64_t      const & dt) const = 0;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////
+    /// \brief      Opposite of the squared tracking error of a segment of the state.
+    ///////////////////////////////////////////////////////////////////////////////
+    class TrackingReward : public AbstractRewardTerm
+    {
+    public:
+        TrackingReward(uint32_t  const & startIdx,
+                       vectorN_t const & target);
+        virtual ~TrackingReward(void) = default;
+
+        virtual result_t initialize(Model const & model) override;
+        virtual float64_t compute(Model          const & model,
+                                  stepperState_t const & stepperState,
+                                  float64_t      const & dt) const override;
+
+        void setTarget(vectorN_t const & target);
+
+    private:
+        uint32_t startIdx_;
+        vectorN_t target_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////
+    /// \brief      Opposite of the squared norm of the motor torques.
+    ///////////////////////////////////////////////////////////////////////////////
+    class TorqueReward : public AbstractRewardTerm
+    {
+    public:
+        TorqueReward(void) = default;
+        virtual ~TorqueReward(void) = default;
+
+        virtual float64_t compute(Model          const & model,
+                                  stepperState_t const & stepperState,
+                                  float64_t      const & dt) const override;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////
+    /// \brief      Opposite of the mechanical energy spent by the motors during the step.
+    ///////////////////////////////////////////////////////////////////////////////
+    class EnergyReward : public AbstractRewardTerm
+    {
+    public:
+        EnergyReward(void);
+        virtual ~EnergyReward(void) = default;
+
+        virtual result_t initialize(Model const & model) override;
+        virtual float64_t compute(Model          const & model,
+                                  stepperState_t const & stepperState,
+                                  float64_t      const & dt) const override;
+
+    private:
+        std::vector<int32_t> motorsVelocityIdx_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////
+    /// \brief      Constant reward for every step, to encourage staying alive.
+    ///////////////////////////////////////////////////////////////////////////////
+    class SurvivalReward : public AbstractRewardTerm
+    {
+    public:
+        SurvivalReward(void) = default;
+        virtual ~SurvivalReward(void) = default;
+
+        virtual float64_t compute(Model          const & model,
+                                  stepperState_t const & stepperState,
+                                  float64_t      const & dt) const override;
+    };
+
+    class Environment
+    {
+    public:
+        // Disable the copy of the class
+        Environment(Environment const & environment) = delete;
+        Environment & operator = (Environment const & other) = delete;
+
+    public:
+        Environment(void);
+        ~Environment(void) = default;
+
+        result_t initialize(std::shared_ptr<Engine> const & engine);
+
+        /// \brief Append a segment of the state to the observation.
+        result_t addObservationState(uint32_t const & startIdx,
+                                     uint32_t const & size);
+        /// \brief Append the data of every sensor of a given type to the observation, sensor after sensor.
+        result_t addObservationSensors(std::string const & sensorType);
+        result_t addRewardTerm(std::shared_ptr<AbstractRewardTerm> const & rewardTerm,
+                               float64_t                            const & weight);
+        result_t addTerminationCondition(std::shared_ptr<AbstractTerminationCondition> const & condition);
+        void clear(void);
+
+        ///////////////////////////////////////////////////////////////////////////////
+        /// \brief      Resolve the observation, reward and termination for the current model.
+        ///
+        /// \details    It must be called once the simulation has started, and before the
+        ///             first call to compute.
+        ///////////////////////////////////////////////////////////////////////////////
+        result_t reset(void);
+
+        ///////////////////////////////////////////////////////////////////////////////
+        /// \brief      Compute the observation, the reward and the termination flag for
+        ///             the current state of the engine.
+        ///
+        /// \details    The reward is computed over the time elapsed since the previous
+        ///             call to compute or reset. The observation is stored internally.
+        ///////////////////////////////////////////////////////////////////////////////
+        result_t compute(float64_t & reward,
+                         bool_t    & isDone);
+
+        vectorN_t const & getObservation(void) const;
+        uint32_t const & getObservationSize(void) const;
+        bool_t const & getIsInitialized(void) const;
+        Engine & getEngine(void) const;
+
+    private:
+        struct observationComponent_t
+        {
+            uint32_t startIdx;                  ///< Start index in the state, or in the flat sensors data of the model, resolved at reset.
+            uint32_t size;
+            std::string sensorType;             ///< Type of sensors. Empty for segments of the state.
+        };
+
+    private:
+        bool_t isInitialized_;
+        bool_t isReady_;
+        std::shared_ptr<Engine> engine_;
+        std::vector<observationComponent_t> observationComponents_;
+        std::vector<std::pair<std::shared_ptr<AbstractRewardTerm>, float64_t> > rewardTerms_;
+        std::vector<std::shared_ptr<AbstractTerminationCondition> > terminationConditions_;
+        vectorN_t observation_;
+        uint32_t observationSize_;
+        float64_t tPrev_;                       ///< Time of the previous call to compute.
+    };
+}
+
+#endif //end of JIMINY_ENVIRONMENT_H
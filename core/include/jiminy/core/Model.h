@@ -27,6 +27,50 @@ namespace jiminy
     class TelemetryData;
     class Engine;
 
+    ///////////////////////////////////////////////////////////////////////////////
+    /// \brief      Read-only description of a robot, loaded from its URDF file.
+    ///
+    /// \details    It is shared between every model of the same robot, so that the
+    ///             URDF file is parsed only once, and a single kinematic tree is kept
+    ///             in memory for any number of parallel simulations. Everything that
+    ///             depends on the simulation, namely the biased model, the data and
+    ///             the state of the motors and sensors, belongs to each model.
+    ///////////////////////////////////////////////////////////////////////////////
+    struct ModelDescription
+    {
+    public:
+        ModelDescription(void);
+
+        /// \brief Load the description from a URDF file.
+        ///
+        /// \details If a cache file is specified, the description is loaded from it when it
+        ///          matches the content of the URDF file. Otherwise, the URDF file is parsed
+        ///          and the cache file is (re)generated.
+        ///
+        /// \param[in] urdfPath        Path of the URDF file.
+        /// \param[in] hasFreeflyer    Whether or not to add a freeflyer joint at the root.
+        /// \param[in] cachePath       Path of the binary cache file. Empty to disable the cache.
+        result_t initialize(std::string const & urdfPath,
+                            bool_t      const & hasFreeflyer,
+                            std::string const & cachePath = std::string());
+
+        /// \brief Write the description in a compact binary file.
+        ///
+        /// \details The file is keyed by a hash of the content of the URDF file and of the
+        ///          freeflyer flag, so that a stale cache is never loaded.
+        result_t save(std::string const & filename) const;
+        result_t load(std::string const & filename,
+                      std::string const & urdfPath,
+                      bool_t      const & hasFreeflyer);
+
+    public:
+        std::string urdfPath;
+        bool_t hasFreeflyer;
+        pinocchio::Model pncModelRigid;                     ///< Rigid model, as described by the URDF
+        std::vector<std::string> rigidJointsNames;          ///< Name of the actual joints of the model, not taking into account the freeflyer
+        uint64_t key;                                       ///< Hash of the content of the URDF file and of the freeflyer flag
+    };
+
     class Model
     {
     public:
@@ -139,7 +183,10 @@ namespace jiminy
         virtual ~Model(void);
 
         result_t initialize(std::string const & urdfPath,
-                            bool_t      const & hasFreeflyer = true);
+                            bool_t      const & hasFreeflyer = true,
+                            std::string const & cachePath = std::string());
+        /// \brief Initialize the model from a description shared with other models.
+        result_t initialize(std::shared_ptr<ModelDescription const> const & description);
 
         result_t addContactPoints(std::vector<std::string> const & frameNames);
         result_t removeContactPoints(std::vector<std::string> const & frameNames = {});
@@ -174,6 +221,17 @@ namespace jiminy
         matrixN_t getSensorsData(std::string const & sensorType) const;
         vectorN_t getSensorData(std::string const & sensorType,
                                 std::string const & motorName) const;
+        /// \brief Latest data of every sensor, stored contiguously.
+        ///
+        /// \details The data are gathered by type of sensors in alphabetical order, then by
+        ///          sensor index. The layout only changes when sensors are attached or detached.
+        vectorN_t const & getSensorsDataFlat(void) const;
+        result_t getSensorsDataSegment(std::string const & sensorType,
+                                       uint32_t          & offset,
+                                       uint32_t          & size) const;
+        result_t getSensorDataOffset(std::string const & sensorType,
+                                     std::string const & sensorName,
+                                     uint32_t          & offset) const;
 
         result_t setOptions(configHolder_t mdlOptions); // Make a copy !
         configHolder_t getOptions(void) const;
@@ -207,6 +265,8 @@ namespace jiminy
         bool_t const & getIsInitialized(void) const;
         std::string const & getUrdfPath(void) const;
         bool_t const & getHasFreeflyer(void) const;
+        std::shared_ptr<ModelDescription const> const & getDescription(void) const;
+        pinocchio::Model const & getModelRigidOrig(void) const;
         // Getters without 'get' prefix for consistency with pinocchio C++ API
         uint32_t const & nq(void) const;
         uint32_t const & nv(void) const;
@@ -242,21 +302,25 @@ namespace jiminy
         bool_t const & getIsLocked(void) const;
 
     protected:
-        result_t loadUrdfModel(std::string const & urdfPath,
-                               bool_t      const & hasFreeflyer);
         result_t generateModelFlexible(void);
         result_t generateModelBiased(void);
         result_t refreshContactProxies(void);
         result_t refreshMotorProxies(void);
+        void refreshSensorsKinematicsProxies(void);
+        void refreshSensorsDataProxies(void);
+        void computeSensorsKinematics(void);
         virtual result_t refreshProxies(void);
 
     public:
         pinocchio::Model pncModel_;
         mutable pinocchio::Data pncData_;
-        pinocchio::Model pncModelRigidOrig_;
         pinocchio::Data pncDataRigidOrig_;
         std::unique_ptr<modelOptions_t const> mdlOptions_;
         forceVector_t contactForces_;                       ///< Buffer storing the contact forces
+        std::vector<int32_t> sensorsFramesIdx_;             ///< Indices of the frames whose kinematics is required by the sensors, without duplicates
+        matrixN_t sensorsFramesQuat_;                       ///< Orientation of the frames of the sensors, one column of quaternion coefficients (x,y,z,w) per frame
+        matrixN_t sensorsFramesGyro_;                       ///< Angular velocity of the frames of the sensors in local frame
+        matrixN_t sensorsFramesAccel_;                      ///< Linear acceleration of the frames of the sensors in local frame, including the gravity
 
     protected:
         bool_t isInitialized_;
@@ -269,6 +333,8 @@ namespace jiminy
         motorsHolder_t motorsHolder_;
         sensorsGroupHolder_t sensorsGroupHolder_;
         std::unordered_map<std::string, bool_t> sensorTelemetryOptions_;
+        vectorN_t sensorsDataFlat_;                         ///< Latest data of every sensor, stored contiguously. The sensors are writing their data in it directly.
+        std::unordered_map<std::string, std::pair<uint32_t, uint32_t> > sensorsDataSegments_;  ///< Offset and size of the data of each type of sensors in the flat data
 
         std::vector<std::string> contactFramesNames_;       ///< Name of the frames of the contact points of the model
         std::vector<int32_t> contactFramesIdx_;             ///< Indices of the contact frames in the frame list of the model
@@ -291,7 +357,10 @@ namespace jiminy
 
     private:
         MutexLocal mutexLocal_;
-        pinocchio::Model pncModelFlexibleOrig_;
+        std::shared_ptr<ModelDescription const> description_;
+        std::shared_ptr<pinocchio::Model const> pncModelFlexibleOrig_;     ///< Shares the rigid model of the description if there is no flexibility
+        std::shared_ptr<pinocchio::Model const> pncModelBiasedOrig_;       ///< Original model from which the current model has been copied, before adding the biases
+        bool_t isModelBiased_;                                              ///< Whether or not the current model differs from its original model
         std::shared_ptr<MotorSharedDataHolder_t> motorsSharedHolder_;
         std::unordered_map<std::string, std::shared_ptr<SensorSharedDataHolder_t> > sensorsSharedHolder_;
         uint32_t nq_;
@@ -0,0 +1,204 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief       Declaration of the TelemetryDataset class, responsible of gathering
+///              the logs of many simulations in a single file.
+///
+/// \details     The telemetry header (constants and column names) is stored only
+///              once, followed by the data rows of every episode, and finally by
+///              the table of episodes. A row is made of the int32 timestamp (in us),
+///              the integer data section and the float data section, without line
+///              token, so that the file can be memory mapped and any episode or
+///              column can be accessed in constant time.
+///
+///              Layout of the file:
+///                 [datasetPreamble_t][telemetry header][padding]
+///                 [rows of episode 0][rows of episode 1]...
+///                 [datasetEpisode_t of episode 0][datasetEpisode_t of episode 1]...
+///
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef JIMINY_TELEMETRY_DATASET_H
+#define JIMINY_TELEMETRY_DATASET_H
+
+#include <fstream>
+#include <memory>
+
+#include "jiminy/core/AbstractIODevice.h"
+#include "jiminy/core/Types.h"
+
+
+namespace jiminy
+{
+    int32_t     const TELEMETRY_DATASET_VERSION = 1;         ///< Version of the dataset format.
+    std::string const DATASET_MAGIC("JiminyDataset");        ///< Marker of the beginning of a dataset file.
+
+    class TelemetryRecorder;
+
+    struct datasetPreamble_t
+    {
+        char_t  magic[16];          ///< Dataset file marker.
+        int32_t version;            ///< Version of the dataset format.
+        int32_t numIntEntries;      ///< Number of integers per row, including Global.Time.
+        int32_t numFloatEntries;    ///< Number of floats per row.
+        int32_t rowSize;            ///< Size in bytes of a row.
+        int64_t headerSize;         ///< Size in bytes of the telemetry header.
+        int64_t dataOffset;         ///< Position of the beginning of the data section (in bytes).
+        int64_t indexOffset;        ///< Position of the beginning of the table of episodes (in bytes).
+        int64_t numEpisodes;        ///< Number of episodes in the dataset.
+    };
+
+    struct datasetEpisode_t
+    {
+        int64_t offset;             ///< Position of the first row of the episode (in bytes).
+        int64_t numRows;            ///< Number of rows of the episode.
+    };
+
+    template<typename T>
+    using datasetColumn_t = Eigen::Map<Eigen::Matrix<T, Eigen::Dynamic, 1> const, 0, Eigen::InnerStride<> >;
+
+    ////////////////////////////////////////////////////////////////////////
+    /// \class TelemetryDataset
+    ////////////////////////////////////////////////////////////////////////
+    class TelemetryDataset
+    {
+    public:
+        // Disable the copy of the class
+        TelemetryDataset(TelemetryDataset const &) = delete;
+        TelemetryDataset & operator=(TelemetryDataset const &) = delete;
+
+    public:
+        TelemetryDataset(void);
+        ~TelemetryDataset(void);
+
+        ////////////////////////////////////////////////////////////////////////
+        /// \brief Open a dataset file.
+        /// \details In READ_ONLY mode, the file is memory mapped and the data can be
+        ///          accessed but not modified. In WRITE_ONLY or READ_WRITE modes, the
+        ///          file is created if necessary and the episodes are appended to it.
+        ///          The TRUNCATE flag can be used to discard the existing episodes.
+        ///
+        /// \param[in] filename  Path of the dataset file.
+        /// \param[in] mode      Opening mode.
+        ///
+        /// \return SUCCESS if successful, the corresponding error otherwise.
+        ////////////////////////////////////////////////////////////////////////
+        result_t open(std::string   const & filename,
+                      enum OpenMode const & mode);
+
+        ////////////////////////////////////////////////////////////////////////
+        /// \brief Close the dataset file. Every data view is invalidated, unless
+        ///        the mapping has been shared beforehand, see getMapping.
+        /// \details The table of episodes is written at this point if the dataset
+        ///          is writable, so that appending an episode does not require to
+        ///          rewrite the whole table.
+        ////////////////////////////////////////////////////////////////////////
+        void close(void);
+
+        ////////////////////////////////////////////////////////////////////////
+        /// \brief Write the table of episodes and the preamble of a writable dataset.
+        ////////////////////////////////////////////////////////////////////////
+        result_t flush(void);
+
+        bool_t isOpen(void) const;
+        bool_t isWritable(void) const;
+
+        ////////////////////////////////////////////////////////////////////////
+        /// \brief Append the content of a recorder as a new episode.
+        /// \details The telemetry header of the recorder must be the same as the one
+        ///          of the episodes already stored in the dataset.
+        ///
+        /// \param[in] recorder  Recorder holding the log of the episode.
+        ///
+        /// \return SUCCESS if successful, the corresponding error otherwise.
+        ////////////////////////////////////////////////////////////////////////
+        result_t appendEpisode(TelemetryRecorder & recorder);
+
+        ////////////////////////////////////////////////////////////////////////
+        /// \brief Get the header, vector of field names, in the same format as the
+        ///        one of TelemetryRecorder::getData.
+        ////////////////////////////////////////////////////////////////////////
+        std::vector<std::string> const & getHeader(void) const;
+
+        ////////////////////////////////////////////////////////////////////////
+        /// \brief Get the index of a column, Global.Time being the column 0.
+        ///
+        /// \return -1 if the field does not exist, the index of the column otherwise.
+        ////////////////////////////////////////////////////////////////////////
+        int32_t getColumnIdx(std::string const & fieldName) const;
+
+        int64_t getNumEpisodes(void) const;
+        int32_t getNumIntEntries(void) const;
+        int32_t getNumFloatEntries(void) const;
+        int64_t getEpisodeLength(int64_t const & episodeIdx) const;
+
+        ////////////////////////////////////////////////////////////////////////
+        /// \brief Get a read-only view of an integer column of an episode.
+        /// \warning Only available in READ_ONLY mode. The view is invalidated
+        ///          when the dataset is closed.
+        ///
+        /// \param[in] episodeIdx  Index of the episode.
+        /// \param[in] columnIdx   Index of the column, in [0, numIntEntries[.
+        ///
+        /// \return Strided view on the column, empty if the indices are invalid.
+        ////////////////////////////////////////////////////////////////////////
+        datasetColumn_t<int32_t> getIntColumn(int64_t const & episodeIdx,
+                                              int32_t const & columnIdx) const;
+
+        ////////////////////////////////////////////////////////////////////////
+        /// \brief Get a read-only view of a float column of an episode.
+        /// \warning Only available in READ_ONLY mode. The view is invalidated
+        ///          when the dataset is closed.
+        ///
+        /// \param[in] episodeIdx  Index of the episode.
+        /// \param[in] columnIdx   Index of the column, in [numIntEntries, numIntEntries + numFloatEntries[.
+        ///
+        /// \return Strided view on the column, empty if the indices are invalid.
+        ////////////////////////////////////////////////////////////////////////
+        datasetColumn_t<float32_t> getFloatColumn(int64_t const & episodeIdx,
+                                                  int32_t const & columnIdx) const;
+
+        ////////////////////////////////////////////////////////////////////////
+        /// \brief Get the address of the first row of an episode, and the size of a row.
+        /// \warning Only available in READ_ONLY mode.
+        ////////////////////////////////////////////////////////////////////////
+        char_t const * getEpisodeRaw(int64_t const & episodeIdx,
+                                     int64_t       & numRows,
+                                     int32_t       & rowSize) const;
+
+        ////////////////////////////////////////////////////////////////////////
+        /// \brief Get the memory mapped file, in READ_ONLY mode only.
+        /// \details The file remains mapped as long as a copy of the pointer is
+        ///          alive, even if the dataset is closed, so that it can be used to
+        ///          keep the data views valid.
+        ////////////////////////////////////////////////////////////////////////
+        std::shared_ptr<char_t const> const & getMapping(void) const;
+
+        ////////////////////////////////////////////////////////////////////////
+        /// \brief Get the full content of an episode, in the same format as Engine::getLogData.
+        ////////////////////////////////////////////////////////////////////////
+        result_t getEpisodeData(int64_t   const & episodeIdx,
+                                matrixN_t       & logData) const;
+
+    private:
+        result_t openRead(std::string const & filename);
+        result_t openWrite(std::string   const & filename,
+                           enum OpenMode const & mode);
+        result_t checkPreamble(int64_t const & fileSize) const;
+        result_t parseHeader(char_t const * headerRaw);
+
+    private:
+        std::string filename_;
+        enum OpenMode modes_;               ///< Current opening mode.
+        std::fstream file_;                 ///< Output stream, only used when the dataset is writable.
+        std::shared_ptr<char_t const> mapping_;     ///< Memory mapped file, or fallback buffer if not available. Only used when the dataset is read-only.
+        char_t const * mappedAddress_;              ///< Address of the memory mapped file.
+        int64_t mappedSize_;                        ///< Size of the memory mapped file.
+
+        datasetPreamble_t preamble_;
+        std::vector<char_t> headerRaw_;             ///< Raw telemetry header.
+        std::vector<std::string> header_;           ///< Parsed telemetry header.
+        std::vector<datasetEpisode_t> episodes_;    ///< Table of episodes.
+    };
+}
+
+#endif // JIMINY_TELEMETRY_DATASET_H
@@ -15,6 +15,7 @@
 namespace jiminy
 {
     uint32_t const MAX_BUFFER_SIZE = (256U * 1024U); // 256Ko
+    uint32_t const TRANSPOSE_BLOCK_SIZE = (64U * 1024U); // 64Ko, to remain in cache while transposing
 
     class TelemetryData;
 
@@ -64,7 +65,67 @@ namespace jiminy
                      std::vector<float64_t>               & timestamps,
                      std::vector<std::vector<int32_t> >   & intData,
                      std::vector<std::vector<float32_t> > & floatData);
+
+        ////////////////////////////////////////////////////////////////////////
+        /// \brief Get the recorded data column by column.
+        /// \details Each chunk is read at once, then the line tokens are checked
+        ///          in bulk to find the number of valid lines, and finally the lines
+        ///          are transposed by blocks small enough to remain in cache. The
+        ///          parsing stops at the first invalid line token of each chunk.
+        ///          The blocks are evenly split between several threads, each of
+        ///          them writing its own rows of the output matrices.
+        ///
+        /// \param[out] header      Header, vector of field names.
+        /// \param[out] timestamps  Global.Time, in seconds.
+        /// \param[out] intData     Integer data, one column per variable.
+        /// \param[out] floatData   Float data, one column per variable.
+        /// \param[in]  numThreads  Number of threads transposing the blocks. 0 to use the number of cores.
+        ////////////////////////////////////////////////////////////////////////
+        static result_t getDataColumns(std::vector<std::string>         & header,
+                                       vectorN_t                        & timestamps,
+                                       intDataMatrix_t                  & intData,
+                                       floatDataMatrix_t                & floatData,
+                                       std::vector<AbstractIODevice *>  & flows,
+                                       int64_t                    const & integerSectionSize,
+                                       int64_t                    const & floatSectionSize,
+                                       int64_t                    const & headerSize,
+                                       uint32_t                   const & numThreads = 0U);
+        result_t getDataColumns(std::vector<std::string> & header,
+                                vectorN_t                & timestamps,
+                                intDataMatrix_t          & intData,
+                                floatDataMatrix_t        & floatData,
+                                uint32_t           const & numThreads = 0U);
+
+        ////////////////////////////////////////////////////////////////////////
+        /// \brief Get the raw header of the record, as formatted by TelemetryData.
+        ///
+        /// \param[out] header  Raw header, including the version flag. Empty if the
+        ///                    recorder is not initialized.
+        ////////////////////////////////////////////////////////////////////////
+        void getHeaderRaw(std::vector<char_t> & header);
+
+        ////////////////////////////////////////////////////////////////////////
+        /// \brief Get the recorded data lines stripped of their line token.
+        /// \details Each row is made of the int32 timestamp (in us), followed by
+        ///          the integer data section and the float data section.
+        ///
+        /// \param[out] rows             Contiguous buffer holding every row.
+        /// \param[out] numIntEntries    Number of integers per row, including the timestamp.
+        /// \param[out] numFloatEntries  Number of floats per row.
+        ///
+        /// \return Number of rows.
+        ////////////////////////////////////////////////////////////////////////
+        int64_t getDataRows(std::vector<char_t> & rows,
+                            int32_t             & numIntEntries,
+                            int32_t             & numFloatEntries);
     private:
+        ////////////////////////////////////////////////////////////////////////
+        /// \brief Parse the header at the beginning of a flow.
+        ////////////////////////////////////////////////////////////////////////
+        static void readHeader(AbstractIODevice         * flow,
+                               int64_t            const & headerSize,
+                               std::vector<std::string> & header);
+
         ////////////////////////////////////////////////////////////////////////
         /// \brief   Create a new file to continue the recording.
         /// \details Each chunk shall have a size defined by LARGE_LOG_SIZE_GB and shall
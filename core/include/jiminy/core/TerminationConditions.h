@@ -0,0 +1,194 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief       Native termination conditions of a simulation.
+///
+/// \details     The conditions are evaluated on the state of the system only,
+///              so that they can be checked at every step without any round
+///              trip to the caller.
+///
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef JIMINY_TERMINATION_CONDITIONS_H
+#define JIMINY_TERMINATION_CONDITIONS_H
+
+#include "pinocchio/multibody/data.hpp"
+
+#include "jiminy/core/Utilities.h"
+#include "jiminy/core/Types.h"
+
+
+namespace jiminy
+{
+    class Model;
+
+    class AbstractTerminationCondition
+    {
+    public:
+        // Disable the assignment of the class
+        AbstractTerminationCondition & operator = (AbstractTerminationCondition const & other) = delete;
+
+    public:
+        AbstractTerminationCondition(void) = default;
+        virtual ~AbstractTerminationCondition(void) = default;
+
+        ///////////////////////////////////////////////////////////////////////////////
+        /// \brief      Get an independent copy of the condition.
+        ///
+        /// \details    The conditions have internal buffers, so that every engine must
+        ///             own its copy to be able to check them concurrently.
+        ///////////////////////////////////////////////////////////////////////////////
+        virtual std::shared_ptr<AbstractTerminationCondition> clone(void) const = 0;
+
+        ///////////////////////////////////////////////////////////////////////////////
+        /// \brief      Resolve everything that depends on the model.
+        ///
+        /// \details    It must be called every time the simulation starts, since the
+        ///             dimensions of the model may have changed.
+        ///////////////////////////////////////////////////////////////////////////////
+        virtual result_t initialize(Model const & model);
+
+        ///////////////////////////////////////////////////////////////////////////////
+        /// \brief      Check whether or not the simulation must be terminated.
+        ///
+        /// \param[in]  model   Model of the system.
+        /// \param[in]  t       Current time.
+        /// \param[in]  x       Current state of the system.
+        ///////////////////////////////////////////////////////////////////////////////
+        virtual bool_t isTriggered(Model     const & model,
+                                   float64_t const & t,
+                                   vectorN_t const & x) const = 0;
+
+    protected:
+        // The copy is only available to clone the conditions
+        AbstractTerminationCondition(AbstractTerminationCondition const & condition) = default;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////
+    /// \brief      Triggered if a segment of the state is out of bounds.
+    ///////////////////////////////////////////////////////////////////////////////
+    class StateBoundsCondition : public AbstractTerminationCondition
+    {
+    public:
+        StateBoundsCondition(uint32_t  const & startIdx,
+                             vectorN_t const & lowerBound,
+                             vectorN_t const & upperBound);
+        virtual ~StateBoundsCondition(void) = default;
+
+        virtual std::shared_ptr<AbstractTerminationCondition> clone(void) const override;
+
+        virtual result_t initialize(Model const & model) override;
+        virtual bool_t isTriggered(Model     const & model,
+                                   float64_t const & t,
+                                   vectorN_t const & x) const override;
+
+    private:
+        uint32_t startIdx_;
+        vectorN_t lowerBound_;
+        vectorN_t upperBound_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////
+    /// \brief      Triggered if the state is not finite, ie the integration failed.
+    ///////////////////////////////////////////////////////////////////////////////
+    class NanCondition : public AbstractTerminationCondition
+    {
+    public:
+        NanCondition(void) = default;
+        virtual ~NanCondition(void) = default;
+
+        virtual std::shared_ptr<AbstractTerminationCondition> clone(void) const override;
+
+        virtual bool_t isTriggered(Model     const & model,
+                                   float64_t const & t,
+                                   vectorN_t const & x) const override;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////
+    /// \brief      Base class for the conditions on the placement of a frame.
+    ///
+    /// \details    The placement is computed from the state, using a dedicated data
+    ///             buffer, since the one of the model is not necessarily up-to-date.
+    ///////////////////////////////////////////////////////////////////////////////
+    class AbstractFrameCondition : public AbstractTerminationCondition
+    {
+    public:
+        AbstractFrameCondition(std::string const & frameName);
+        virtual ~AbstractFrameCondition(void) = default;
+
+        virtual result_t initialize(Model const & model) override;
+
+    protected:
+        pinocchio::SE3 const & computeFramePlacement(Model     const & model,
+                                                     vectorN_t const & x) const;
+
+    private:
+        std::string frameName_;
+        int32_t frameIdx_;
+        mutable pinocchio::Data pncData_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////
+    /// \brief      Triggered if the height of a frame is lower than a threshold.
+    ///////////////////////////////////////////////////////////////////////////////
+    class FrameHeightCondition : public AbstractFrameCondition
+    {
+    public:
+        FrameHeightCondition(std::string const & frameName,
+                             float64_t   const & heightMin);
+        virtual ~FrameHeightCondition(void) = default;
+
+        virtual std::shared_ptr<AbstractTerminationCondition> clone(void) const override;
+
+        virtual bool_t isTriggered(Model     const & model,
+                                   float64_t const & t,
+                                   vectorN_t const & x) const override;
+
+    private:
+        float64_t heightMin_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////
+    /// \brief      Triggered if the angle between the vertical axis of a frame and the
+    ///             one of the world is larger than a threshold.
+    ///////////////////////////////////////////////////////////////////////////////
+    class FrameOrientationCondition : public AbstractFrameCondition
+    {
+    public:
+        FrameOrientationCondition(std::string const & frameName,
+                                  float64_t   const & angleMax);
+        virtual ~FrameOrientationCondition(void) = default;
+
+        virtual std::shared_ptr<AbstractTerminationCondition> clone(void) const override;
+
+        virtual bool_t isTriggered(Model     const & model,
+                                   float64_t const & t,
+                                   vectorN_t const & x) const override;
+
+    private:
+        float64_t cosAngleMax_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////
+    /// \brief      Triggered if the wall-clock time elapsed since the initialization
+    ///             is larger than a budget.
+    ///////////////////////////////////////////////////////////////////////////////
+    class WallClockCondition : public AbstractTerminationCondition
+    {
+    public:
+        WallClockCondition(float64_t const & durationMax);
+        virtual ~WallClockCondition(void) = default;
+
+        virtual std::shared_ptr<AbstractTerminationCondition> clone(void) const override;
+
+        virtual result_t initialize(Model const & model) override;
+        virtual bool_t isTriggered(Model     const & model,
+                                   float64_t const & t,
+                                   vectorN_t const & x) const override;
+
+    private:
+        float64_t durationMax_;
+        mutable Timer timer_;
+    };
+}
+
+#endif //end of JIMINY_TERMINATION_CONDITIONS_H
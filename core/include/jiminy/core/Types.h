@@ -39,6 +39,8 @@ namespace jiminy
     using vector3_t = Eigen::Matrix<float64_t, 3, 1>;
     using vector6_t = Eigen::Matrix<float64_t, 6, 1>;
     using rowN_t = Eigen::Matrix<float64_t, 1, Eigen::Dynamic>;
+    using intDataMatrix_t = Eigen::Matrix<int32_t, Eigen::Dynamic, Eigen::Dynamic>;
+    using floatDataMatrix_t = Eigen::Matrix<float32_t, Eigen::Dynamic, Eigen::Dynamic>;
 
     using constBlockXpr = Eigen::Block<matrixN_t const, Eigen::Dynamic, Eigen::Dynamic>;
     using blockXpr = Eigen::Block<matrixN_t, Eigen::Dynamic, Eigen::Dynamic>;
@@ -119,9 +121,9 @@ namespace jiminy
         sensorDataTypePair_t(sensorDataTypePair_t const & sensorDataPairIn) = delete;
         sensorDataTypePair_t & operator = (sensorDataTypePair_t const & other) = delete;
 
-        sensorDataTypePair_t(std::string const & nameIn,
-                             int32_t     const & idIn,
-                             vectorN_t   const * valueIn) :
+        sensorDataTypePair_t(std::string                 const & nameIn,
+                             int32_t                     const & idIn,
+                             Eigen::Ref<vectorN_t const> const & valueIn) :
         name(nameIn),
         id(idIn),
         value(valueIn)
@@ -141,7 +143,7 @@ namespace jiminy
 
         std::string name;
         int32_t id;
-        vectorN_t const * value;
+        Eigen::Ref<vectorN_t const> value;  ///< View on the measurement, stored in the column 'id' of the data of the sensors of the same type
     };
 
     using namespace boost::multi_index;
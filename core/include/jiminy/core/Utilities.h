@@ -73,8 +73,45 @@ namespace jiminy
 
     // ************ Random number generator utilities ***************
 
+    // State of the random number generators. Each engine owns its own state, so that
+    // the random numbers only depend on the seed and the engine, not on the thread
+    // running it. Otherwise, the default state of the calling thread is used.
+    struct randomGeneratorState_t
+    {
+    public:
+        randomGeneratorState_t(void);
+
+    public:
+        std::mt19937 generator;     // Generator of the Ziggurat algorithm
+        uint32_t philoxKey[2];      // Key of the counter-based generator
+        uint64_t philoxCounter;     // Index of the next block of the counter-based generator
+    };
+
+    // Use a given state for the random numbers generated by the calling thread,
+    // for the lifetime of the object. The previous state is restored afterward.
+    class ScopedRandomGeneratorState
+    {
+    public:
+        // Disable the copy of the class
+        ScopedRandomGeneratorState(ScopedRandomGeneratorState const &) = delete;
+        ScopedRandomGeneratorState & operator = (ScopedRandomGeneratorState const &) = delete;
+
+    public:
+        ScopedRandomGeneratorState(randomGeneratorState_t & state);
+        ~ScopedRandomGeneratorState(void);
+
+    private:
+        randomGeneratorState_t * statePrevious_;
+    };
+
+    // Reset the default state of the calling thread, and the global generator of Eigen
     void resetRandGenerators(uint32_t seed);
 
+    // Reset a given state, the stream index giving independent sequences for the same seed
+    void resetRandGenerators(randomGeneratorState_t       & state,
+                             uint32_t               const & seed,
+                             uint32_t               const & streamIdx);
+
     float64_t randUniform(float64_t const & lo,
                           float64_t const & hi);
 
@@ -93,6 +130,9 @@ namespace jiminy
     vectorN_t randVectorNormal(vectorN_t const & mean,
                                vectorN_t const & std);
 
+    // Fill a preallocated matrix with standard normal samples, generated in bulk
+    void randMatrixNormal(matrixN_t & samples);
+
     // ******************* Telemetry utilities **********************
 
     std::vector<std::string> defaultVectorFieldnames(std::string const & baseName,
@@ -108,8 +148,7 @@ namespace jiminy
     void computePositionDerivative(pinocchio::Model            const & model,
                                    Eigen::Ref<vectorN_t const>         q,
                                    Eigen::Ref<vectorN_t const>         v,
-                                   Eigen::Ref<vectorN_t>               qDot,
-                                   float64_t                           dt = 1e-5); // Make a copy
+                                   Eigen::Ref<vectorN_t>               qDot);
 
     // Pinocchio joint types
     enum class joint_t : int32_t
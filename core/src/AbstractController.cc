@@ -2,6 +2,7 @@
 
 #include "jiminy/core/Utilities.h"
 #include "jiminy/core/Model.h"
+#include "jiminy/core/AbstractSensor.h"
 #include "jiminy/core/AbstractController.h"
 
 
@@ -15,7 +16,9 @@ namespace jiminy
     ctrlOptionsHolder_(),
     telemetrySender_(),
     registeredVariables_(),
-    registeredConstants_()
+    registeredConstants_(),
+    registeredSensors_(),
+    registeredSensorsSegments_()
     {
         AbstractController::setOptions(getDefaultOptions()); // Clarify that the base implementation is called
     }
@@ -73,9 +76,74 @@ namespace jiminy
             removeEntries();
         }
 
+        // Resolve the registered sensors again, since they may have been attached or detached since then
+        if (isInitialized_)
+        {
+            for (uint32_t i = 0; i < registeredSensors_.size(); i++)
+            {
+                if (getSensorSegment(registeredSensors_[i].first,
+                                     registeredSensors_[i].second,
+                                     registeredSensorsSegments_[i]) != result_t::SUCCESS)
+                {
+                    registeredSensorsSegments_[i] = {0U, 0U};
+                }
+            }
+        }
+
         isTelemetryConfigured_ = false;
     }
 
+    result_t AbstractController::getSensorSegment(std::string                   const & sensorType,
+                                                  std::string                   const & sensorName,
+                                                  std::pair<uint32_t, uint32_t>       & segment) const
+    {
+        result_t returnCode = result_t::SUCCESS;
+
+        std::shared_ptr<AbstractSensorBase const> sensor;
+        returnCode = model_->getSensor(sensorType, sensorName, sensor);
+
+        if (returnCode == result_t::SUCCESS)
+        {
+            returnCode = model_->getSensorDataOffset(sensorType, sensorName, segment.first);
+        }
+
+        if (returnCode == result_t::SUCCESS)
+        {
+            segment.second = sensor->getSize();
+        }
+
+        return returnCode;
+    }
+
+    result_t AbstractController::registerSensor(std::string const & sensorType,
+                                                std::string const & sensorName,
+                                                uint32_t          & sensorIdx)
+    {
+        if (!isInitialized_)
+        {
+            std::cout << "Error - AbstractController::registerSensor - The controller is not initialized." << std::endl;
+            return result_t::ERROR_INIT_FAILED;
+        }
+
+        std::pair<uint32_t, uint32_t> segment;
+        result_t returnCode = getSensorSegment(sensorType, sensorName, segment);
+
+        if (returnCode == result_t::SUCCESS)
+        {
+            registeredSensors_.emplace_back(sensorType, sensorName);
+            registeredSensorsSegments_.push_back(segment);
+            sensorIdx = registeredSensors_.size() - 1;
+        }
+
+        return returnCode;
+    }
+
+    Eigen::Ref<vectorN_t const> AbstractController::getSensorData(uint32_t const & sensorIdx) const
+    {
+        std::pair<uint32_t, uint32_t> const & segment = registeredSensorsSegments_[sensorIdx];
+        return model_->getSensorsDataFlat().segment(segment.first, segment.second);
+    }
+
     result_t AbstractController::configureTelemetry(std::shared_ptr<TelemetryData> const & telemetryData)
     {
         result_t returnCode = result_t::SUCCESS;
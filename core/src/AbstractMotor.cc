@@ -1,3 +1,8 @@
+#include <limits>
+#include <iterator>
+#include <algorithm>
+#include <typeindex>
+
 #include "jiminy/core/AbstractMotor.h"
 #include "jiminy/core/Model.h"
 #include "jiminy/core/Utilities.h"
@@ -55,6 +60,9 @@ namespace jiminy
         sharedHolder_->motors_.push_back(this);
         ++sharedHolder_->num_;
 
+        // The banks must be gathered again
+        sharedHolder_->banks_.clear();
+
         // Update the flag
         isAttached_ = true;
 
@@ -92,6 +100,9 @@ namespace jiminy
         // Update the total number of motors left
         --sharedHolder_->num_;
 
+        // The banks must be gathered again
+        sharedHolder_->banks_.clear();
+
         // Clear the references to the model and shared data
         model_ = nullptr;
         sharedHolder_ = nullptr;
@@ -277,6 +288,79 @@ namespace jiminy
         sharedHolder_->data_ = vectorN_t::Zero(sharedHolder_->num_);
     }
 
+    void AbstractMotorBase::refreshBanks(void)
+    {
+        std::vector<MotorSharedDataHolder_t::motorBank_t> & banks = sharedHolder_->banks_;
+        std::vector<std::type_index> banksType;
+
+        banks.clear();
+        for (AbstractMotorBase * motor : sharedHolder_->motors_)
+        {
+            std::type_index const motorType(typeid(*motor));
+            auto bankTypeIt = std::find(banksType.begin(), banksType.end(), motorType);
+            if (bankTypeIt == banksType.end())
+            {
+                banksType.push_back(motorType);
+                banks.emplace_back();
+                banks.back().isInitialized = true;
+                bankTypeIt = std::prev(banksType.end());
+            }
+
+            MotorSharedDataHolder_t::motorBank_t & bank = banks[std::distance(banksType.begin(), bankTypeIt)];
+            bank.motors.push_back(motor);
+            bank.motorsIdx.push_back(motor->motorId_);
+            bank.positionIdx.push_back(motor->jointPositionIdx_);
+            bank.velocityIdx.push_back(motor->jointVelocityIdx_);
+            bank.isInitialized &= motor->isInitialized_;
+        }
+
+        for (MotorSharedDataHolder_t::motorBank_t & bank : banks)
+        {
+            uint32_t const numMotors = bank.motors.size();
+            bank.q.setZero(numMotors);
+            bank.v.setZero(numMotors);
+            bank.a.setZero(numMotors);
+            bank.uCommand.setZero(numMotors);
+            bank.u.setZero(numMotors);
+            bank.torqueLimit.resize(numMotors);
+            for (uint32_t i = 0; i < numMotors; i++)
+            {
+                AbstractMotorBase const * motor = bank.motors[i];
+                if (motor->baseMotorOptions_->enableTorqueLimit)
+                {
+                    bank.torqueLimit[i] = motor->torqueLimit_;
+                }
+                else
+                {
+                    bank.torqueLimit[i] = std::numeric_limits<float64_t>::infinity();
+                }
+            }
+            bank.motors[0]->refreshBank(bank);
+        }
+    }
+
+    void AbstractMotorBase::refreshBank(MotorSharedDataHolder_t::motorBank_t & bank) const
+    {
+        // Empty.
+    }
+
+    result_t AbstractMotorBase::computeEffortBank(float64_t                            const & t,
+                                                  MotorSharedDataHolder_t::motorBank_t       & bank)
+    {
+        result_t returnCode = result_t::SUCCESS;
+
+        for (uint32_t i = 0; i < bank.motors.size(); i++)
+        {
+            if (returnCode == result_t::SUCCESS)
+            {
+                returnCode = bank.motors[i]->computeEffort(t, bank.q[i], bank.v[i], bank.a[i], bank.uCommand[i]);
+                bank.u[i] = bank.motors[i]->get();
+            }
+        }
+
+        return returnCode;
+    }
+
     result_t AbstractMotorBase::computeAllEffort(float64_t const & t,
                                                  vectorN_t const & q,
                                                  vectorN_t const & v,
@@ -285,17 +369,44 @@ namespace jiminy
     {
         result_t returnCode = result_t::SUCCESS;
 
-        // Compute the motors' output
-        for (AbstractMotorBase * motor : sharedHolder_->motors_)
+        if (sharedHolder_->banks_.empty())
+        {
+            refreshBanks();
+        }
+
+        for (MotorSharedDataHolder_t::motorBank_t & bank : sharedHolder_->banks_)
         {
+            if (!bank.isInitialized)
+            {
+                std::cout << "Error - AbstractMotorBase::computeAllEffort - Motor not initialized. Impossible to compute actual motor torque." << std::endl;
+                returnCode = result_t::ERROR_INIT_FAILED;
+            }
+
             if (returnCode == result_t::SUCCESS)
             {
-                // Compute the actual torque
-                returnCode = motor->computeEffort(t,
-                                                  q[motor->getJointPositionIdx()],
-                                                  v[motor->getJointVelocityIdx()],
-                                                  a[motor->getJointVelocityIdx()],
-                                                  uCommand[motor->getIdx()]);
+                // Gather the inputs of the motors of the bank
+                uint32_t const numMotors = bank.motors.size();
+                for (uint32_t i = 0; i < numMotors; i++)
+                {
+                    bank.q[i] = q[bank.positionIdx[i]];
+                    bank.v[i] = v[bank.velocityIdx[i]];
+                    bank.a[i] = a[bank.velocityIdx[i]];
+                    bank.uCommand[i] = uCommand[bank.motorsIdx[i]];
+                }
+
+                // Compute the actual torque of every motor of the bank at once
+                returnCode = bank.motors[0]->computeEffortBank(t, bank);
+
+                // Scatter the actual torques
+                for (uint32_t i = 0; i < numMotors; i++)
+                {
+                    sharedHolder_->data_[bank.motorsIdx[i]] = bank.u[i];
+                }
+            }
+
+            if (returnCode != result_t::SUCCESS)
+            {
+                break;
             }
         }
 
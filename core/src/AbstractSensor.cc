@@ -1,9 +1,162 @@
+#include <cmath>
+#include <iterator>
+#include <algorithm>
+
 #include "jiminy/core/AbstractSensor.h"
 #include "jiminy/core/Model.h"
 
 
 namespace jiminy
 {
+    void SensorSharedDataHolder_t::clearHistory(uint32_t const & dataSize,
+                                                uint32_t const & capacityMin)
+    {
+        uint32_t const capacity = std::max(static_cast<uint32_t>(time_.size()), capacityMin);
+        if (time_.size() != capacity)
+        {
+            time_.resize(capacity);
+        }
+        if (data_.rows() != dataSize || data_.cols() != capacity * num_)
+        {
+            data_.resize(dataSize, capacity * num_);
+        }
+
+        historyHead_ = 0;
+        historySize_ = 2;
+        historyFirst_ = 0;
+        for (delayGroup_t & group : delayGroups_)
+        {
+            group.cursor = 0;
+        }
+        time_[0] = -1;
+        time_[1] = 0;
+        data_.leftCols(2 * num_).setZero();
+    }
+
+    void SensorSharedDataHolder_t::pushBackHistory(void)
+    {
+        uint32_t const capacity = time_.size();
+        if (historySize_ == capacity)
+        {
+            // Unroll the history at the beginning of the new buffers
+            vectorN_t timeNew(2 * capacity);
+            matrixN_t dataNew(data_.rows(), 2 * capacity * num_);
+            for (uint32_t i = 0; i < historySize_; i++)
+            {
+                timeNew[i] = time(i);
+                dataNew.middleCols(i * num_, num_) = data_.middleCols(getHistoryIdx(i) * num_, num_);
+            }
+            time_.swap(timeNew);
+            data_.swap(dataNew);
+            historyHead_ = 0;
+        }
+
+        ++historySize_;
+    }
+
+    void SensorSharedDataHolder_t::resizeDataMeasured(uint32_t const & dataSize,
+                                                      int32_t  const & num)
+    {
+        vectorN_t storage = vectorN_t::Zero(dataSize * num);
+        if (dataMeasured_.rows() == dataSize)
+        {
+            int32_t const numKept = std::min(num, static_cast<int32_t>(dataMeasured_.cols()));
+            Eigen::Map<matrixN_t>(storage.data(), dataSize, num).leftCols(numKept) = dataMeasured_.leftCols(numKept);
+        }
+        dataMeasuredStorage_.swap(storage);
+        new (&dataMeasured_) Eigen::Map<matrixN_t>(dataMeasuredStorage_.data(), dataSize, num);
+    }
+
+    void SensorSharedDataHolder_t::bindDataMeasured(float64_t * data)
+    {
+        if (data != dataMeasured_.data())
+        {
+            Eigen::Index const dataSize = dataMeasured_.rows();
+            Eigen::Index const num = dataMeasured_.cols();
+            Eigen::Map<matrixN_t>(data, dataSize, num) = dataMeasured_;
+            new (&dataMeasured_) Eigen::Map<matrixN_t>(data, dataSize, num);
+            dataMeasuredStorage_.resize(0);
+        }
+    }
+
+    int32_t SensorSharedDataHolder_t::findDelayedIdx(delayGroup_t       & group,
+                                                     float64_t    const & timeDesired)
+    {
+        if (timeDesired < time(0))
+        {
+            return -1;
+        }
+
+        // Start from the previous sample, which may have been dropped since then
+        int32_t const historySize = static_cast<int32_t>(historySize_);
+        int32_t idx = static_cast<int32_t>(group.cursor) - static_cast<int32_t>(historyFirst_);
+        idx = std::min(std::max(idx, 0), historySize - 1);
+
+        // It always terminates since the oldest sample is older than timeDesired
+        while (timeDesired < time(idx))
+        {
+            --idx;
+        }
+        while (idx + 1 < historySize && time(idx + 1) <= timeDesired)
+        {
+            ++idx;
+        }
+
+        group.cursor = historyFirst_ + idx;
+        return idx;
+    }
+
+    void SensorSharedDataHolder_t::refreshDelayGroups(void)
+    {
+        delayGroups_.clear();
+        sensorsDelayGroupIdx_.resize(num_);
+        for (int32_t i = 0; i < num_; i++)
+        {
+            float64_t const & delay = sensors_[i]->baseSensorOptions_->delay;
+            uint32_t const & delayInterpolationOrder = sensors_[i]->baseSensorOptions_->delayInterpolationOrder;
+
+            auto groupIt = std::find_if(delayGroups_.begin(), delayGroups_.end(),
+                [&delay, &delayInterpolationOrder](delayGroup_t const & group) -> bool_t
+                {
+                    return std::abs(group.delay - delay) < EPS
+                        && group.delayInterpolationOrder == delayInterpolationOrder;
+                });
+            if (groupIt == delayGroups_.end())
+            {
+                delayGroups_.push_back({delay, delayInterpolationOrder, std::vector<int32_t>(), 0U});
+                groupIt = std::prev(delayGroups_.end());
+            }
+
+            groupIt->sensorsIdx.push_back(i);
+            sensorsDelayGroupIdx_[i] = std::distance(delayGroups_.begin(), groupIt);
+        }
+    }
+
+    void SensorSharedDataHolder_t::refreshNoiseAndBias(uint32_t const & dataSize)
+    {
+        noiseStd_.setZero(dataSize, num_);
+        bias_.setZero(dataSize, num_);
+        noise_.resize(dataSize, num_);
+        hasNoise_ = false;
+        hasBias_ = false;
+        for (int32_t i = 0; i < num_; i++)
+        {
+            vectorN_t const & noiseStd = sensors_[i]->baseSensorOptions_->noiseStd;
+            if (noiseStd.size() == dataSize)
+            {
+                noiseStd_.col(i) = noiseStd;
+                hasNoise_ = true;
+            }
+
+            vectorN_t const & bias = sensors_[i]->baseSensorOptions_->bias;
+            if (bias.size() == dataSize)
+            {
+                bias_.col(i) = bias;
+                hasBias_ = true;
+            }
+        }
+    }
+
     AbstractSensorBase::AbstractSensorBase(std::string const & name) :
     baseSensorOptions_(nullptr),
     sensorOptionsHolder_(),
@@ -12,7 +165,7 @@ namespace jiminy
     isTelemetryConfigured_(false),
     model_(nullptr),
     name_(name),
-    data_(),
+    kinematicsIdx_(-1),
     telemetrySender_()
     {
         // Initialize the options
@@ -36,7 +189,7 @@ namespace jiminy
                 if (telemetryData)
                 {
                     telemetrySender_.configureObject(telemetryData, getTelemetryName());
-                    returnCode = telemetrySender_.registerVariable(getFieldNames(), data_);
+                    returnCode = telemetrySender_.registerVariable(getFieldNames(), get());
                     if (returnCode == result_t::SUCCESS)
                     {
                         isTelemetryConfigured_ = true;
@@ -58,7 +211,7 @@ namespace jiminy
         if(isTelemetryConfigured_)
         {
             updateDataBuffer(); // Force update the internal measurement buffer if necessary
-            telemetrySender_.updateValue(getFieldNames(), data_);
+            telemetrySender_.updateValue(getFieldNames(), get());
         }
     }
 
@@ -88,4 +241,9 @@ namespace jiminy
     {
         return name_;
     }
+
+    int32_t AbstractSensorBase::getKinematicsFrameIdx(void) const
+    {
+        return -1;
+    }
 }
\ No newline at end of file
@@ -89,6 +89,41 @@ namespace jiminy
         return returnCode;
     }
 
+    void SimpleMotor::refreshBank(MotorSharedDataHolder_t::motorBank_t & bank) const
+    {
+        /* The friction coefficients are gathered as one column per coefficient,
+           set to zero if the friction of the motor is disabled. */
+        bank.parameters.setZero(bank.motors.size(), 5);
+        for (uint32_t i = 0; i < bank.motors.size(); i++)
+        {
+            motorOptions_t const & motorOptions = *static_cast<SimpleMotor const *>(bank.motors[i])->motorOptions_;
+            if (motorOptions.enableFriction)
+            {
+                bank.parameters(i, 0) = motorOptions.frictionViscousPositive;
+                bank.parameters(i, 1) = motorOptions.frictionViscousNegative;
+                bank.parameters(i, 2) = motorOptions.frictionDryPositive;
+                bank.parameters(i, 3) = motorOptions.frictionDryNegative;
+                bank.parameters(i, 4) = motorOptions.frictionDrySlope;
+            }
+        }
+    }
+
+    result_t SimpleMotor::computeEffortBank(float64_t                            const & t,
+                                            MotorSharedDataHolder_t::motorBank_t       & bank)
+    {
+        // Enforce the torque limits, which are infinite if disabled
+        bank.u = bank.uCommand.array().min(bank.torqueLimit.array()).max(-bank.torqueLimit.array());
+
+        // Add friction to the joints associated with the motors, which is zero if disabled
+        auto const vMotor = bank.v.array();
+        auto const isVelocityPositive = (vMotor > 0.0);
+        bank.u.array() += isVelocityPositive.select(bank.parameters.col(0).array(), bank.parameters.col(1).array()) * vMotor
+                        + isVelocityPositive.select(bank.parameters.col(2).array(), bank.parameters.col(3).array())
+                        * (bank.parameters.col(4).array() * vMotor).tanh();
+
+        return result_t::SUCCESS;
+    }
+
     result_t SimpleMotor::computeEffort(float64_t const & t,
                                         float64_t const & q,
                                         float64_t const & v,
@@ -85,6 +85,15 @@ namespace jiminy
         return frameName_;
     }
 
+    int32_t ImuSensor::getKinematicsFrameIdx(void) const
+    {
+        if (!isInitialized_)
+        {
+            return -1;
+        }
+        return frameIdx_;
+    }
+
     result_t ImuSensor::set(float64_t const & t,
                             vectorN_t const & q,
                             vectorN_t const & v,
@@ -97,13 +106,16 @@ namespace jiminy
             return result_t::ERROR_INIT_FAILED;
         }
 
-        matrix3_t const & rot = model_->pncData_.oMf[frameIdx_].rotation();
-        quaternion_t const quat(rot); // Convert a rotation matrix to a quaternion
-        data().head<4>() = quat.coeffs(); // (x,y,z,w)
-        pinocchio::Motion const gyroIMU = pinocchio::getFrameVelocity(model_->pncModel_, model_->pncData_, frameIdx_);
-        data().segment<3>(4) = gyroIMU.angular();
-        pinocchio::Motion const acceleration = pinocchio::getFrameAcceleration(model_->pncModel_, model_->pncData_, frameIdx_);
-        data().tail<3>() = acceleration.linear() + quat.conjugate() * model_->pncModel_.gravity.linear();
+        if (kinematicsIdx_ < 0)
+        {
+            std::cout << "Error - ImuSensor::set - The kinematics of the frame is not computed by the model. Please reset it first." << std::endl;
+            return result_t::ERROR_INIT_FAILED;
+        }
+
+        // The kinematics of the frame is shared with the other sensors attached to it
+        data().head<4>() = model_->sensorsFramesQuat_.col(kinematicsIdx_); // (x,y,z,w)
+        data().segment<3>(4) = model_->sensorsFramesGyro_.col(kinematicsIdx_);
+        data().tail<3>() = model_->sensorsFramesAccel_.col(kinematicsIdx_);
 
         return result_t::SUCCESS;
     }
@@ -120,7 +132,8 @@ namespace jiminy
     ForceSensor::ForceSensor(std::string const & name) :
     AbstractSensorTpl(name),
     frameName_(),
-    frameIdx_(0)
+    frameIdx_(0),
+    contactIdx_(-1)
     {
         // Empty.
     }
@@ -173,6 +186,20 @@ namespace jiminy
             returnCode = getFrameIdx(model_->pncModel_, frameName_, frameIdx_);
         }
 
+        if (returnCode == result_t::SUCCESS)
+        {
+            std::vector<int32_t> const & contactFramesIdx = model_->getContactFramesIdx();
+            auto contactIt = std::find(contactFramesIdx.begin(), contactFramesIdx.end(), frameIdx_);
+            if (contactIt != contactFramesIdx.end())
+            {
+                contactIdx_ = std::distance(contactFramesIdx.begin(), contactIt);
+            }
+            else
+            {
+                contactIdx_ = -1;
+            }
+        }
+
         return returnCode;
     }
 
@@ -193,9 +220,13 @@ namespace jiminy
             return result_t::ERROR_INIT_FAILED;
         }
 
-        std::vector<int32_t> const & contactFramesIdx = model_->getContactFramesIdx();
-        std::vector<int32_t>::const_iterator it = std::find(contactFramesIdx.begin(), contactFramesIdx.end(), frameIdx_);
-        data() = model_->contactForces_[std::distance(contactFramesIdx.begin(), it)].linear();
+        if (contactIdx_ < 0)
+        {
+            std::cout << "Error - ForceSensor::set - The frame of the sensor is not a contact point of the model." << std::endl;
+            return result_t::ERROR_GENERIC;
+        }
+
+        data() = model_->contactForces_[contactIdx_].linear();
 
         return result_t::SUCCESS;
     }
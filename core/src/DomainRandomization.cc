@@ -0,0 +1,62 @@
+#include <algorithm>
+
+#include "jiminy/core/Utilities.h"
+#include "jiminy/core/DomainRandomization.h"
+
+
+namespace jiminy
+{
+    DomainRandomization::DomainRandomization(void) :
+    parameters_(),
+    scalesBounds_()
+    {
+        // Empty.
+    }
+
+    result_t DomainRandomization::addParameter(randomizedParameter_t const & parameter,
+                                               float64_t             const & scaleMin,
+                                               float64_t             const & scaleMax)
+    {
+        if (scaleMin < 0.0 || scaleMax < scaleMin)
+        {
+            std::cout << "Error - DomainRandomization::addParameter - The scale bounds must be positive and ordered." << std::endl;
+            return result_t::ERROR_BAD_INPUT;
+        }
+
+        if (std::find(parameters_.begin(), parameters_.end(), parameter) != parameters_.end())
+        {
+            std::cout << "Error - DomainRandomization::addParameter - The parameter is already randomized." << std::endl;
+            return result_t::ERROR_BAD_INPUT;
+        }
+
+        parameters_.push_back(parameter);
+        scalesBounds_.emplace_back(scaleMin, scaleMax);
+
+        return result_t::SUCCESS;
+    }
+
+    void DomainRandomization::clear(void)
+    {
+        parameters_.clear();
+        scalesBounds_.clear();
+    }
+
+    void DomainRandomization::sample(vectorN_t & scales) const
+    {
+        scales.resize(parameters_.size());
+        for (uint32_t i = 0; i < parameters_.size(); i++)
+        {
+            scales[i] = randUniform(scalesBounds_[i].first, scalesBounds_[i].second);
+        }
+    }
+
+    std::vector<randomizedParameter_t> const & DomainRandomization::getParameters(void) const
+    {
+        return parameters_;
+    }
+
+    uint32_t DomainRandomization::getNumParameters(void) const
+    {
+        return parameters_.size();
+    }
+}
@@ -14,6 +14,7 @@
 #include "jiminy/core/FileDevice.h"
 #include "jiminy/core/TelemetryData.h"
 #include "jiminy/core/TelemetryRecorder.h"
+#include "jiminy/core/TelemetryDataset.h"
 #include "jiminy/core/AbstractController.h"
 #include "jiminy/core/Model.h"
 #include "jiminy/core/AbstractMotor.h"
@@ -29,6 +30,272 @@ namespace jiminy
     float64_t const DEFAULT_SIMULATION_TIMESTEP = 1e-3;
     float64_t const MAX_SIMULATION_TIMESTEP = 5e-3;
 
+    runge_kutta_lie::runge_kutta_lie(pinocchio::Model const & model,
+                                     matrixN_t        const & A,
+                                     vectorN_t        const & b,
+                                     vectorN_t        const & c,
+                                     vectorN_t        const & bError,
+                                     order_type       const & order,
+                                     float64_t        const & tolAbs,
+                                     float64_t        const & tolRel) :
+    model_(&model),
+    A_(A),
+    b_(b),
+    c_(c),
+    bError_(bError),
+    order_(order),
+    tolAbs_(tolAbs),
+    tolRel_(tolRel),
+    isFsal_(false),
+    lieJoints_(),
+    K_(matrixN_t::Zero(2 * model.nv, c.size())),
+    dxStep_(vectorN_t::Zero(2 * model.nv)),
+    dxError_(vectorN_t::Zero(2 * model.nv)),
+    xStage_(vectorN_t::Zero(model.nq + model.nv)),
+    dxdtStage_(vectorN_t::Zero(model.nq + model.nv))
+    {
+        /* The last stage is the end of the step if its time is the end of the step and its
+           weights are the ones of the solution, the last one being zero. */
+        uint32_t const nStages = c_.size();
+        isFsal_ = std::abs(c_[nStages - 1] - 1.0) < EPS
+               && std::abs(b_[nStages - 1]) < EPS
+               && A_.row(nStages - 1).head(nStages - 1).isApprox(b_.head(nStages - 1).transpose());
+
+        /* Only the joints whose configuration space is a non-abelian Lie group require a
+           correction. It is not the case of unbounded rotary joints for instance. */
+        for (int32_t i = 1; i < model.njoints; i++)
+        {
+            auto const & jointVariant = model.joints[i].toVariant();
+            if (boost::get<pinocchio::JointModelFreeFlyer>(&jointVariant))
+            {
+                lieJoints_.emplace_back(model.joints[i].idx_v(), joint_t::FREE);
+            }
+            else if (boost::get<pinocchio::JointModelSpherical>(&jointVariant))
+            {
+                lieJoints_.emplace_back(model.joints[i].idx_v(), joint_t::SPHERICAL);
+            }
+            else if (boost::get<pinocchio::JointModelPlanar>(&jointVariant))
+            {
+                lieJoints_.emplace_back(model.joints[i].idx_v(), joint_t::PLANAR);
+            }
+        }
+    }
+
+    runge_kutta_lie runge_kutta_lie::dopri5(pinocchio::Model const & model,
+                                            float64_t        const & tolAbs,
+                                            float64_t        const & tolRel)
+    {
+        matrixN_t A = matrixN_t::Zero(7, 7);
+        A.row(1).head<1>() << 1.0 / 5.0;
+        A.row(2).head<2>() << 3.0 / 40.0, 9.0 / 40.0;
+        A.row(3).head<3>() << 44.0 / 45.0, -56.0 / 15.0, 32.0 / 9.0;
+        A.row(4).head<4>() << 19372.0 / 6561.0, -25360.0 / 2187.0, 64448.0 / 6561.0, -212.0 / 729.0;
+        A.row(5).head<5>() << 9017.0 / 3168.0, -355.0 / 33.0, 46732.0 / 5247.0, 49.0 / 176.0, -5103.0 / 18656.0;
+        A.row(6).head<6>() << 35.0 / 384.0, 0.0, 500.0 / 1113.0, 125.0 / 192.0, -2187.0 / 6784.0, 11.0 / 84.0;
+        vectorN_t b(7);
+        b << 35.0 / 384.0, 0.0, 500.0 / 1113.0, 125.0 / 192.0, -2187.0 / 6784.0, 11.0 / 84.0, 0.0;
+        vectorN_t c(7);
+        c << 0.0, 1.0 / 5.0, 3.0 / 10.0, 4.0 / 5.0, 8.0 / 9.0, 1.0, 1.0;
+        vectorN_t bEmbedded(7);
+        bEmbedded << 5179.0 / 57600.0, 0.0, 7571.0 / 16695.0, 393.0 / 640.0,
+                     -92097.0 / 339200.0, 187.0 / 2100.0, 1.0 / 40.0;
+        return runge_kutta_lie(model, A, b, c, b - bEmbedded, 5, tolAbs, tolRel);
+    }
+
+    runge_kutta_lie runge_kutta_lie::rk4(pinocchio::Model const & model)
+    {
+        matrixN_t A = matrixN_t::Zero(4, 4);
+        A(1, 0) = 0.5;
+        A(2, 1) = 0.5;
+        A(3, 2) = 1.0;
+        vectorN_t b(4);
+        b << 1.0 / 6.0, 1.0 / 3.0, 1.0 / 3.0, 1.0 / 6.0;
+        vectorN_t c(4);
+        c << 0.0, 0.5, 0.5, 1.0;
+        return runge_kutta_lie(model, A, b, c, vectorN_t(), 4, 0.0, 0.0);
+    }
+
+    runge_kutta_lie::order_type runge_kutta_lie::order(void) const
+    {
+        return order_;
+    }
+
+    void runge_kutta_lie::integrate(state_type const & x,
+                                    vectorN_t  const & dx,
+                                    state_type       & xNext) const
+    {
+        int32_t const & nq = model_->nq;
+        int32_t const & nv = model_->nv;
+        pinocchio::integrate(*model_, x.head(nq), dx.head(nv), xNext.head(nq));
+        xNext.tail(nv) = x.tail(nv) + dx.tail(nv);
+    }
+
+    void runge_kutta_lie::setStageDerivative(uint32_t   const & stageIdx,
+                                             state_type const & x,
+                                             deriv_type const & dxdt)
+    {
+        // The derivative of the configuration in tangent space is the velocity itself
+        int32_t const & nq = model_->nq;
+        int32_t const & nv = model_->nv;
+        K_.col(stageIdx).head(nv) = x.segment(nq, nv);
+        K_.col(stageIdx).tail(nv) = dxdt.tail(nv);
+    }
+
+    void runge_kutta_lie::correctStageDerivative(uint32_t  const & stageIdx,
+                                                 vectorN_t const & dx)
+    {
+        /* The configuration of the stage is the one at the beginning of the step moved by
+           exp(u), so the derivative of u is dexp^{-1}_{-u}(w) = w + [u, w] / 2 + [u, [u, w]] / 12,
+           w being the velocity of the stage in local frame. */
+        for (auto const & lieJoint : lieJoints_)
+        {
+            int32_t const & idx_v = lieJoint.first;
+            switch (lieJoint.second)
+            {
+            case joint_t::SPHERICAL:
+            {
+                vector3_t const u = dx.segment<3>(idx_v);
+                auto w = K_.col(stageIdx).segment<3>(idx_v);
+                vector3_t const uw = u.cross(w);
+                w += 0.5 * uw + u.cross(uw) / 12.0;
+                break;
+            }
+            case joint_t::FREE:
+            {
+                // Bracket of se3, the linear part being stored first
+                auto bracket = [](vector6_t const & a, vector6_t const & b) -> vector6_t
+                {
+                    vector6_t ab;
+                    ab << a.tail<3>().cross(b.head<3>()) + a.head<3>().cross(b.tail<3>()),
+                          a.tail<3>().cross(b.tail<3>());
+                    return ab;
+                };
+                vector6_t const u = dx.segment<6>(idx_v);
+                auto w = K_.col(stageIdx).segment<6>(idx_v);
+                vector6_t const uw = bracket(u, w);
+                w += 0.5 * uw + bracket(u, uw) / 12.0;
+                break;
+            }
+            case joint_t::PLANAR:
+            {
+                // Bracket of se2, the angular velocity being stored last
+                auto bracket = [](vector3_t const & a, vector3_t const & b) -> vector3_t
+                {
+                    return vector3_t(b[2] * a[1] - a[2] * b[1], a[2] * b[0] - b[2] * a[0], 0.0);
+                };
+                vector3_t const u = dx.segment<3>(idx_v);
+                auto w = K_.col(stageIdx).segment<3>(idx_v);
+                vector3_t const uw = bracket(u, w);
+                w += 0.5 * uw + bracket(u, uw) / 12.0;
+                break;
+            }
+            default:
+                break;
+            }
+        }
+    }
+
+    bool_t runge_kutta_lie::adaptStep(state_type const & x,
+                                      time_type        & t,
+                                      time_type        & dt) const
+    {
+        /* Relative error of each component in tangent space, as the default error checker
+           of odeint, the derivative at the beginning of the step being the first stage. The
+           configuration has no magnitude in tangent space, so only its increment is used. */
+        int32_t const & nv = model_->nv;
+        auto const dqErrorAbs = dxError_.head(nv).array().abs();
+        auto const dvErrorAbs = dxError_.tail(nv).array().abs();
+        auto const dqdtAbs = K_.col(0).head(nv).array().abs();
+        auto const dvdtAbs = K_.col(0).tail(nv).array().abs();
+        auto const vAbs = x.tail(nv).array().abs();
+        float64_t error = std::max(
+            (dqErrorAbs / (tolAbs_ + tolRel_ * dt * dqdtAbs)).maxCoeff(),
+            (dvErrorAbs / (tolAbs_ + tolRel_ * (vAbs + dt * dvdtAbs))).maxCoeff());
+
+        // Same step adjustment as the default one of odeint, the error order being one less
+        if (error > 1.0)
+        {
+            dt *= std::max(0.9 * std::pow(error, -1.0 / (order_ - 2)), 0.2);
+            return false;
+        }
+
+        t += dt;
+        if (error < 0.5)
+        {
+            error = std::max(std::pow(5.0, -static_cast<float64_t>(order_)), error);
+            dt *= 0.9 * std::pow(error, -1.0 / order_);
+        }
+        return true;
+    }
+
+    forceProfilePolynomial_t::forceProfilePolynomial_t(void) :
+    frameName(),
+    frameIdx(0),
+    breakpoints_(),
+    coefficients_(),
+    order_(0),
+    intervalIdx_(0)
+    {
+        // Empty.
+    }
+
+    result_t forceProfilePolynomial_t::initialize(std::string const & frameNameIn,
+                                                  vectorN_t   const & breakpoints,
+                                                  matrixN_t   const & coefficients)
+    {
+        uint32_t const numIntervals = std::max(static_cast<int32_t>(breakpoints.size()) - 1, 0);
+        if (numIntervals == 0U || coefficients.rows() != 3
+         || coefficients.cols() == 0 || coefficients.cols() % numIntervals != 0)
+        {
+            std::cout << "Error - forceProfilePolynomial_t::initialize - The coefficients are inconsistent with the breakpoints." << std::endl;
+            return result_t::ERROR_BAD_INPUT;
+        }
+
+        if (((breakpoints.tail(numIntervals) - breakpoints.head(numIntervals)).array() <= 0.0).any())
+        {
+            std::cout << "Error - forceProfilePolynomial_t::initialize - The breakpoints must be strictly increasing." << std::endl;
+            return result_t::ERROR_BAD_INPUT;
+        }
+
+        frameName = frameNameIn;
+        frameIdx = 0;
+        breakpoints_ = breakpoints;
+        coefficients_ = coefficients;
+        order_ = coefficients.cols() / numIntervals - 1;
+        intervalIdx_ = 0;
+
+        return result_t::SUCCESS;
+    }
+
+    vector3_t forceProfilePolynomial_t::operator()(float64_t const & t)
+    {
+        uint32_t const numIntervals = breakpoints_.size() - 1;
+        if (t < breakpoints_[0] || t >= breakpoints_[numIntervals])
+        {
+            return vector3_t::Zero();
+        }
+
+        // Move the interval from the previous one, either forward or backward
+        while (t >= breakpoints_[intervalIdx_ + 1])
+        {
+            ++intervalIdx_;
+        }
+        while (t < breakpoints_[intervalIdx_])
+        {
+            --intervalIdx_;
+        }
+
+        // Horner scheme
+        float64_t const dt = t - breakpoints_[intervalIdx_];
+        uint32_t const colIdx = intervalIdx_ * (order_ + 1);
+        vector3_t F = coefficients_.col(colIdx + order_);
+        for (uint32_t j = order_; j > 0; j--)
+        {
+            F = F * dt + coefficients_.col(colIdx + j - 1);
+        }
+        return F;
+    }
+
     Engine::Engine(void):
     engineOptions_(nullptr),
     isInitialized_(false),
@@ -41,6 +308,8 @@ namespace jiminy
                  {
                      return true;
                  }),
+    stopConditions_(),
+    domainRandomization_(nullptr),
     lockModel_(),
     telemetrySender_(),
     telemetryData_(nullptr),
@@ -50,8 +319,21 @@ namespace jiminy
     stepperState_(),
     stepperStateLast_(),
     forcesImpulse_(),
-    forceImpulseNextIt_(forcesImpulse_.begin()),
-    forcesProfile_()
+    forceImpulseNextIdx_(0),
+    forcesImpulseActive_(),
+    forcesProfile_(),
+    forcesProfilePolynomial_(),
+    contactParameters_(),
+    domainRandomizationScales_(),
+    randomGeneratorState_(),
+    randomStreamIdx_(0U),
+    jointsLimitsPositionIdx_(),
+    jointsLimitsVelocityIdx_(),
+    jointsLimitsPosition_(),
+    jointsLimitsVelocity_(),
+    jointsLimitsError_(),
+    jointsLimitsForce_(),
+    jointsLimitsTotalForce_()
     {
         // Initialize the configuration options to the default.
         setOptions(getDefaultOptions());
@@ -68,7 +350,7 @@ namespace jiminy
         telemetrySender_.configureObject(telemetryData_, ENGINE_OBJECT_NAME);
 
         // Initialize the random number generators
-        resetRandGenerators(engineOptions_->stepper.randomSeed);
+        resetRandGenerators(randomGeneratorState_, engineOptions_->stepper.randomSeed, randomStreamIdx_);
     }
 
     Engine::~Engine(void) = default; // Cannot be default in the header since some types are incomplete at this point
@@ -227,16 +509,19 @@ namespace jiminy
         if (resetDynamicForceRegister)
         {
             forcesImpulse_.clear();
-            forceImpulseNextIt_ = forcesImpulse_.begin();
             forcesProfile_.clear();
+            forcesProfilePolynomial_.clear();
         }
 
         // Reset the random number generators
         if (resetRandomNumbers)
         {
-            resetRandGenerators(engineOptions_->stepper.randomSeed);
+            resetRandGenerators(randomGeneratorState_, engineOptions_->stepper.randomSeed, randomStreamIdx_);
         }
 
+        // The biases of the model are sampled using the generators of the engine
+        ScopedRandomGeneratorState randomGeneratorStateGuard(randomGeneratorState_);
+
         // Reset the internal state of the model and controller
         model_->reset();
         controller_->reset();
@@ -257,6 +542,9 @@ namespace jiminy
     {
         result_t returnCode = result_t::SUCCESS;
 
+        // The random numbers only depend on the engine, not on the calling thread
+        ScopedRandomGeneratorState randomGeneratorStateGuard(randomGeneratorState_);
+
         if (!isInitialized_)
         {
             std::cout << "Error - Engine::reset - The engine is not initialized." << std::endl;
@@ -264,7 +552,7 @@ namespace jiminy
         }
 
         // Check the dimension of the state
-        if ((isStateTheoretical && (xInit.rows() != model_->pncModelRigidOrig_.nq + model_->pncModelRigidOrig_.nv))
+        if ((isStateTheoretical && (xInit.rows() != model_->getModelRigidOrig().nq + model_->getModelRigidOrig().nv))
         || (!isStateTheoretical && (xInit.rows() != model_->nx())))
         {
             std::cout << "Error - Engine::reset - Size of xInit inconsistent with model size." << std::endl;
@@ -288,6 +576,45 @@ namespace jiminy
             // Propage the user-defined motor inertia at Pinocchio model level
             model_->pncModel_.rotorInertia = model_->getMotorInertia();
 
+            // Reset the contact parameters to their nominal values
+            contactOptions_t const & contactOptions = engineOptions_->contacts;
+            contactParameters_ = {contactOptions.frictionViscous,
+                                  contactOptions.frictionDry,
+                                  contactOptions.stiffness,
+                                  contactOptions.damping};
+
+            /* Flatten the indices of the degrees of freedom of the rigid joints, in the
+               order of the position and velocity limits of the model. */
+            jointsLimitsPositionIdx_.clear();
+            jointsLimitsVelocityIdx_.clear();
+            for (int32_t const & jointIdx : model_->getRigidJointsModelIdx())
+            {
+                auto const & joint = model_->pncModel_.joints[jointIdx];
+                for (int32_t j = 0; j < joint.nq(); j++)
+                {
+                    jointsLimitsPositionIdx_.push_back(joint.idx_q() + j);
+                    jointsLimitsVelocityIdx_.push_back(joint.idx_v() + j);
+                }
+            }
+            uint32_t const jointsLimitsSize = jointsLimitsVelocityIdx_.size();
+            jointsLimitsPosition_.resize(jointsLimitsSize);
+            jointsLimitsVelocity_.resize(jointsLimitsSize);
+            jointsLimitsError_.resize(jointsLimitsSize);
+            jointsLimitsForce_.resize(jointsLimitsSize);
+            jointsLimitsTotalForce_.resize(jointsLimitsSize);
+
+            /* Randomize the parameters of the simulation. It is done after the reset of the
+               model and the motors since it restores the nominal values of their parameters. */
+            if (domainRandomization_)
+            {
+                if (domainRandomizationScales_.size() == 0)
+                {
+                    domainRandomization_->sample(domainRandomizationScales_);
+                }
+                applyDomainRandomization(domainRandomizationScales_);
+            }
+            domainRandomizationScales_.resize(0);
+
             vectorN_t x0 = vectorN_t::Zero(model_->nx());
             if (isStateTheoretical && model_->mdlOptions_->dynamics.enableFlexibleModel)
             {
@@ -328,12 +655,21 @@ namespace jiminy
                 x0 = xInit;
             }
 
-            // Reset the impulse for iterator counter
-            forceImpulseNextIt_ = forcesImpulse_.begin();
+            // Reset the active set of impulse forces, and resolve the frames once and for all
+            forceImpulseNextIdx_ = 0;
+            forcesImpulseActive_.clear();
+            for (auto & forceImpulse : forcesImpulse_)
+            {
+                getFrameIdx(model_->pncModel_, forceImpulse.frameName, forceImpulse.frameIdx);
+            }
             for (auto & forceProfile : forcesProfile_)
             {
                 getFrameIdx(model_->pncModel_, forceProfile.first, std::get<0>(forceProfile.second));
             }
+            for (auto & forceProfile : forcesProfilePolynomial_)
+            {
+                getFrameIdx(model_->pncModel_, forceProfile.frameName, forceProfile.frameIdx);
+            }
 
             // Initialize the ode solver
             if (engineOptions_->stepper.odeSolver == "runge_kutta_dopri5")
@@ -346,6 +682,16 @@ namespace jiminy
             {
                 stepper_ = explicit_euler();
             }
+            else if (engineOptions_->stepper.odeSolver == "runge_kutta_dopri5_lie")
+            {
+                stepper_ = runge_kutta_lie::dopri5(model_->pncModel_,
+                                                   engineOptions_->stepper.tolAbs,
+                                                   engineOptions_->stepper.tolRel);
+            }
+            else if (engineOptions_->stepper.odeSolver == "runge_kutta_4_lie")
+            {
+                stepper_ = runge_kutta_lie::rk4(model_->pncModel_);
+            }
 
             // Compute the initial time step
             float64_t dt;
@@ -407,6 +753,19 @@ namespace jiminy
             model_->setSensorsData(t, q, v, a, uMotor);
         }
 
+        if (returnCode == result_t::SUCCESS)
+        {
+            // Resolve the stop conditions for the current model
+            for (auto const & condition : stopConditions_)
+            {
+                returnCode = condition->initialize(*model_);
+                if (returnCode != result_t::SUCCESS)
+                {
+                    break;
+                }
+            }
+        }
+
         if (returnCode == result_t::SUCCESS)
         {
             // Lock the telemetry. At this point it is no longer possible to register new variables.
@@ -453,8 +812,8 @@ namespace jiminy
         while (returnCode == result_t::SUCCESS)
         {
             /* Stop the simulation if the end time has been reached, if
-               the callback returns false, or if the max number of
-               integration steps is exceeded. */
+               a stop condition is triggered, if the callback returns false,
+               or if the max number of integration steps is exceeded. */
             if (tEnd - stepperState_.t < MIN_SIMULATION_TIMESTEP)
             {
                 if (engineOptions_->stepper.verbose)
@@ -463,6 +822,18 @@ namespace jiminy
                 }
                 break;
             }
+            else if (std::any_of(stopConditions_.begin(), stopConditions_.end(),
+                                 [this](auto const & condition) -> bool_t
+                                 {
+                                     return condition->isTriggered(*model_, stepperState_.t, stepperState_.x);
+                                 }))
+            {
+                if (engineOptions_->stepper.verbose)
+                {
+                    std::cout << "Simulation done: stop condition triggered." << std::endl;
+                }
+                break;
+            }
             else if (!callbackFct_(stepperState_.t, stepperState_.x))
             {
                 if (engineOptions_->stepper.verbose)
@@ -504,6 +875,9 @@ namespace jiminy
     {
         result_t returnCode = result_t::SUCCESS;
 
+        // The random numbers only depend on the engine, not on the calling thread
+        ScopedRandomGeneratorState randomGeneratorStateGuard(randomGeneratorState_);
+
         // Check if the simulation has started
         if (!lockModel_)
         {
@@ -620,7 +994,7 @@ namespace jiminy
                             computeCommand(t, q, v, uCommand);
 
                             /* Update the internal stepper state dxdt since the dynamics has changed.
-                                Make sure the next impulse force iterator has NOT been updated at this point ! */
+                                Make sure the active set of impulse forces has NOT been updated at this point ! */
                             // Note: this point is still subject to debate: it's more a subjective choice
                             // than a true mathematical condition. Numerically the result is similar
                             // with or without this line...
@@ -632,31 +1006,33 @@ namespace jiminy
                     }
                 }
 
-                // Get the next impulse force application time and update the iterator if necessary
+                /* Update the active set of impulse forces, and get the time of the next
+                   breakpoint, namely the next beginning or end of an impulse force. */
+                while (forceImpulseNextIdx_ < forcesImpulse_.size()
+                    && forcesImpulse_[forceImpulseNextIdx_].t < t + EPS)
+                {
+                    forcesImpulseActive_.push_back(forceImpulseNextIdx_);
+                    ++forceImpulseNextIdx_;
+                }
                 float64_t tForceImpulseNext = tEnd;
-                if (forceImpulseNextIt_ != forcesImpulse_.end())
+                if (forceImpulseNextIdx_ < forcesImpulse_.size())
+                {
+                    tForceImpulseNext = min(tForceImpulseNext, forcesImpulse_[forceImpulseNextIdx_].t);
+                }
+                for (uint32_t i = 0; i < forcesImpulseActive_.size(); )
                 {
-                    float64_t tForceImpulseNextTmp = forceImpulseNextIt_->first;
-                    float64_t dtForceImpulseNext = std::get<1>(forceImpulseNextIt_->second);
-                    if (t > tForceImpulseNextTmp + dtForceImpulseNext)
+                    forceImpulse_t const & forceImpulse = forcesImpulse_[forcesImpulseActive_[i]];
+                    float64_t const tForceImpulseEnd = forceImpulse.t + forceImpulse.dt;
+                    if (tForceImpulseEnd < t + EPS)
                     {
-                        ++forceImpulseNextIt_;
-                        tForceImpulseNextTmp = forceImpulseNextIt_->first;
+                        // The order of the active set does not matter
+                        forcesImpulseActive_[i] = forcesImpulseActive_.back();
+                        forcesImpulseActive_.pop_back();
                     }
-
-                    if (forceImpulseNextIt_ != forcesImpulse_.end())
+                    else
                     {
-                        if (tForceImpulseNextTmp > t)
-                        {
-                            tForceImpulseNext = tForceImpulseNextTmp;
-                        }
-                        else
-                        {
-                            if (forceImpulseNextIt_ != std::prev(forcesImpulse_.end()))
-                            {
-                                tForceImpulseNext = std::next(forceImpulseNextIt_)->first;
-                            }
-                        }
+                        tForceImpulseNext = min(tForceImpulseNext, tForceImpulseEnd);
+                        ++i;
                     }
                 }
 
@@ -842,18 +1218,13 @@ namespace jiminy
         }
 
         // Add the effect of user-defined external forces
-        if (forceImpulseNextIt_ != forcesImpulse_.end())
+        for (uint32_t const & forceImpulseIdx : forcesImpulseActive_)
         {
-            float64_t const & tForceImpulseNext = forceImpulseNextIt_->first;
-            float64_t const & dt = std::get<1>(forceImpulseNextIt_->second);
-            if (tForceImpulseNext <= t && t <= tForceImpulseNext + dt)
+            forceImpulse_t const & forceImpulse = forcesImpulse_[forceImpulseIdx];
+            if (forceImpulse.t <= t && t <= forceImpulse.t + forceImpulse.dt)
             {
-                int32_t frameIdx;
-                std::string const & frameName = std::get<0>(forceImpulseNextIt_->second);
-                vector3_t const & F = std::get<2>(forceImpulseNextIt_->second);
-                getFrameIdx(model_->pncModel_, frameName, frameIdx);
-                int32_t const & parentIdx = model_->pncModel_.frames[frameIdx].parent;
-                fext[parentIdx] += pinocchio::Force(computeFrameForceOnParentJoint(frameIdx, F));
+                int32_t const & parentIdx = model_->pncModel_.frames[forceImpulse.frameIdx].parent;
+                fext[parentIdx] += pinocchio::Force(computeFrameForceOnParentJoint(forceImpulse.frameIdx, forceImpulse.F));
             }
         }
 
@@ -864,6 +1235,12 @@ namespace jiminy
             forceFunctor_t const & forceFct = std::get<1>(forceProfile.second);
             fext[parentIdx] += pinocchio::Force(computeFrameForceOnParentJoint(frameIdx, forceFct(t, x)));
         }
+
+        for (auto & forceProfile : forcesProfilePolynomial_)
+        {
+            int32_t const & parentIdx = model_->pncModel_.frames[forceProfile.frameIdx].parent;
+            fext[parentIdx] += pinocchio::Force(computeFrameForceOnParentJoint(forceProfile.frameIdx, forceProfile(t)));
+        }
     }
 
     void Engine::computeCommand(float64_t                   const & t,
@@ -878,20 +1255,141 @@ namespace jiminy
         controller_->computeCommand(t, q, v, u);
     }
 
+    result_t Engine::addStopCondition(std::shared_ptr<AbstractTerminationCondition> const & condition)
+    {
+        // Make sure that the simulation is not running
+        if (lockModel_)
+        {
+            std::cout << "Error - Engine::addStopCondition - A simulation is running. Please stop it before adding a stop condition." << std::endl;
+            return result_t::ERROR_GENERIC;
+        }
+
+        // Each engine owns its copy, so that the conditions can be shared between engines
+        stopConditions_.push_back(condition->clone());
+
+        return result_t::SUCCESS;
+    }
+
+    void Engine::removeStopConditions(void)
+    {
+        stopConditions_.clear();
+    }
+
+    result_t Engine::setDomainRandomization(std::shared_ptr<DomainRandomization const> const & domainRandomization)
+    {
+        // Make sure that the simulation is not running
+        if (lockModel_)
+        {
+            std::cout << "Error - Engine::setDomainRandomization - A simulation is running. Please stop it before setting the randomization." << std::endl;
+            return result_t::ERROR_GENERIC;
+        }
+
+        domainRandomization_ = domainRandomization;
+        domainRandomizationScales_.resize(0);
+
+        return result_t::SUCCESS;
+    }
+
+    result_t Engine::setDomainRandomizationScales(vectorN_t const & scales)
+    {
+        if (lockModel_)
+        {
+            std::cout << "Error - Engine::setDomainRandomizationScales - A simulation is running. Please stop it before setting the randomization." << std::endl;
+            return result_t::ERROR_GENERIC;
+        }
+
+        if (!domainRandomization_)
+        {
+            std::cout << "Error - Engine::setDomainRandomizationScales - No randomization has been set." << std::endl;
+            return result_t::ERROR_INIT_FAILED;
+        }
+
+        if (static_cast<uint32_t>(scales.size()) != domainRandomization_->getNumParameters())
+        {
+            std::cout << "Error - Engine::setDomainRandomizationScales - The number of scales is inconsistent with the randomization." << std::endl;
+            return result_t::ERROR_BAD_INPUT;
+        }
+
+        domainRandomizationScales_ = scales;
+
+        return result_t::SUCCESS;
+    }
+
+    result_t Engine::setRandomStreamIdx(uint32_t const & streamIdx)
+    {
+        if (lockModel_)
+        {
+            std::cout << "Error - Engine::setRandomStreamIdx - A simulation is running. Please stop it before selecting the random numbers." << std::endl;
+            return result_t::ERROR_GENERIC;
+        }
+
+        randomStreamIdx_ = streamIdx;
+        resetRandGenerators(randomGeneratorState_, engineOptions_->stepper.randomSeed, randomStreamIdx_);
+
+        return result_t::SUCCESS;
+    }
+
+    void Engine::applyDomainRandomization(vectorN_t const & scales)
+    {
+        std::vector<randomizedParameter_t> const & parameters = domainRandomization_->getParameters();
+        for (uint32_t i = 0; i < parameters.size(); i++)
+        {
+            float64_t const & scale = scales[i];
+            switch (parameters[i])
+            {
+            case randomizedParameter_t::CONTACT_FRICTION_VISCOUS:
+                contactParameters_.frictionViscous *= scale;
+                break;
+            case randomizedParameter_t::CONTACT_FRICTION_DRY:
+                contactParameters_.frictionDry *= scale;
+                break;
+            case randomizedParameter_t::CONTACT_STIFFNESS:
+                contactParameters_.stiffness *= scale;
+                break;
+            case randomizedParameter_t::CONTACT_DAMPING:
+                contactParameters_.damping *= scale;
+                break;
+            case randomizedParameter_t::MOTORS_TORQUE_LIMIT:
+                for (auto & motor : model_->getMotors())
+                {
+                    motor->torqueLimit_ *= scale;
+                }
+                if (!model_->getMotors().empty())
+                {
+                    (*model_->getMotors().begin())->refreshBanks();
+                }
+                break;
+            case randomizedParameter_t::MOTORS_ROTOR_INERTIA:
+                model_->pncModel_.rotorInertia *= scale;
+                break;
+            }
+        }
+    }
+
     result_t Engine::registerForceImpulse(std::string const & frameName,
                                           float64_t   const & t,
                                           float64_t   const & dt,
                                           vector3_t   const & F)
     {
-        // Make sure that the forces do NOT overlap while taking into account dt.
-
         if (lockModel_)
         {
             std::cout << "Error - Engine::registerForceImpulse - A simulation is running. Please stop it before registering new forces." << std::endl;
             return result_t::ERROR_GENERIC;
         }
 
-        forcesImpulse_[t] = std::make_tuple(frameName, dt, F);
+        if (dt < 0.0)
+        {
+            std::cout << "Error - Engine::registerForceImpulse - The duration of the force must be positive." << std::endl;
+            return result_t::ERROR_BAD_INPUT;
+        }
+
+        // Keep the forces sorted by application time, after the ones already applied at the same time
+        auto forceImpulseIt = std::upper_bound(forcesImpulse_.begin(), forcesImpulse_.end(), t,
+                                               [](float64_t const & tIn, forceImpulse_t const & forceImpulse)
+                                               {
+                                                   return tIn < forceImpulse.t;
+                                               });
+        forcesImpulse_.insert(forceImpulseIt, forceImpulse_t{frameName, 0, t, dt, F});
 
         return result_t::SUCCESS;
     }
@@ -912,6 +1410,49 @@ namespace jiminy
         return result_t::SUCCESS;
     }
 
+    result_t Engine::registerForceProfileTabulated(std::string const & frameName,
+                                                   vectorN_t   const & t,
+                                                   matrixN_t   const & F)
+    {
+        if (t.size() < 2 || F.rows() != t.size() || F.cols() != 3)
+        {
+            std::cout << "Error - Engine::registerForceProfileTabulated - The forces must be of size (number of samples, 3), with at least 2 samples." << std::endl;
+            return result_t::ERROR_BAD_INPUT;
+        }
+
+        // Linear interpolation is a piecewise-polynomial of order 1
+        uint32_t const numIntervals = t.size() - 1;
+        matrixN_t coefficients(2 * numIntervals, 3);
+        for (uint32_t k = 0; k < numIntervals; k++)
+        {
+            coefficients.row(2 * k) = F.row(k);
+            coefficients.row(2 * k + 1) = (F.row(k + 1) - F.row(k)) / (t[k + 1] - t[k]);
+        }
+
+        return registerForceProfilePolynomial(frameName, t, coefficients);
+    }
+
+    result_t Engine::registerForceProfilePolynomial(std::string const & frameName,
+                                                    vectorN_t   const & breakpoints,
+                                                    matrixN_t   const & coefficients)
+    {
+        if (lockModel_)
+        {
+            std::cout << "Error - Engine::registerForceProfilePolynomial - A simulation is running. Please stop it before registering new forces." << std::endl;
+            return result_t::ERROR_GENERIC;
+        }
+
+        forceProfilePolynomial_t forceProfile;
+        result_t returnCode = forceProfile.initialize(frameName, breakpoints, coefficients.transpose());
+
+        if (returnCode == result_t::SUCCESS)
+        {
+            forcesProfilePolynomial_.push_back(std::move(forceProfile));
+        }
+
+        return returnCode;
+    }
+
     configHolder_t const & Engine::getOptions(void) const
     {
         return engineOptionsHolder_;
@@ -936,7 +1477,8 @@ namespace jiminy
 
         // Make sure the selected ode solver is available and instantiate it
         std::string const & odeSolver = boost::get<std::string>(stepperOptions.at("odeSolver"));
-        if (odeSolver != "runge_kutta_dopri5" && odeSolver != "explicit_euler")
+        if (odeSolver != "runge_kutta_dopri5" && odeSolver != "explicit_euler"
+         && odeSolver != "runge_kutta_dopri5_lie" && odeSolver != "runge_kutta_4_lie")
         {
             std::cout << "Error - Engine::setOptions - The requested 'odeSolver' is not available." << std::endl;
             return result_t::ERROR_BAD_INPUT;
@@ -1047,27 +1589,15 @@ namespace jiminy
         return stepperState_;
     }
 
-    void logDataRawToEigenMatrix(std::vector<float64_t>               const & timestamps,
-                                 std::vector<std::vector<int32_t> >   const & intData,
-                                 std::vector<std::vector<float32_t> > const & floatData,
-                                 matrixN_t                                  & logData)
+    void logDataColumnsToEigenMatrix(vectorN_t         const & timestamps,
+                                     intDataMatrix_t   const & intData,
+                                     floatDataMatrix_t const & floatData,
+                                     matrixN_t               & logData)
     {
-        // Never empty since it contains at least the initial state
-        logData.resize(timestamps.size(), 1 + intData[0].size() + floatData[0].size());
-        logData.col(0) = Eigen::Matrix<float64_t, 1, Eigen::Dynamic>::Map(
-            timestamps.data(), timestamps.size());
-        for (uint32_t i=0; i<intData.size(); i++)
-        {
-            logData.block(i, 1, 1, intData[i].size()) =
-                Eigen::Matrix<int32_t, 1, Eigen::Dynamic>::Map(
-                    intData[i].data(), intData[i].size()).cast<float64_t>();
-        }
-        for (uint32_t i=0; i<floatData.size(); i++)
-        {
-            logData.block(i, 1 + intData[0].size(), 1, floatData[i].size()) =
-                Eigen::Matrix<float32_t, 1, Eigen::Dynamic>::Map(
-                    floatData[i].data(), floatData[i].size()).cast<float64_t>();
-        }
+        logData.resize(timestamps.size(), 1 + intData.cols() + floatData.cols());
+        logData.col(0) = timestamps;
+        logData.middleCols(1, intData.cols()) = intData.cast<float64_t>();
+        logData.rightCols(floatData.cols()) = floatData.cast<float64_t>();
     }
 
     void Engine::getLogDataRaw(std::vector<std::string>             & header,
@@ -1078,14 +1608,22 @@ namespace jiminy
         telemetryRecorder_->getData(header, timestamps, intData, floatData);
     }
 
+    void Engine::getLogDataColumns(std::vector<std::string> & header,
+                                   vectorN_t                & timestamps,
+                                   intDataMatrix_t          & intData,
+                                   floatDataMatrix_t        & floatData)
+    {
+        telemetryRecorder_->getDataColumns(header, timestamps, intData, floatData);
+    }
+
     void Engine::getLogData(std::vector<std::string> & header,
                             matrixN_t                & logData)
     {
-        std::vector<float64_t> timestamps;
-        std::vector<std::vector<int32_t> > intData;
-        std::vector<std::vector<float32_t> > floatData;
-        getLogDataRaw(header, timestamps, intData, floatData);
-        logDataRawToEigenMatrix(timestamps, intData, floatData, logData);
+        vectorN_t timestamps;
+        intDataMatrix_t intData;
+        floatDataMatrix_t floatData;
+        getLogDataColumns(header, timestamps, intData, floatData);
+        logDataColumnsToEigenMatrix(timestamps, intData, floatData, logData);
     }
 
     vectorN_t Engine::getLogFieldValue(std::string              const & fieldName,
@@ -1148,16 +1686,16 @@ namespace jiminy
         return telemetryRecorder_->writeDataBinary(filename);
     }
 
-    result_t Engine::parseLogBinaryRaw(std::string                          const & filename,
-                                       std::vector<std::string>                   & header,
-                                       std::vector<float64_t>                     & timestamps,
-                                       std::vector<std::vector<int32_t> >         & intData,
-                                       std::vector<std::vector<float32_t> >       & floatData)
+    result_t Engine::writeLogDataset(TelemetryDataset & dataset)
     {
-        int64_t integerSectionSize;
-        int64_t floatSectionSize;
-        int64_t headerSize;
+        return dataset.appendEpisode(*telemetryRecorder_);
+    }
 
+    result_t getLogBinaryLayout(std::string const & filename,
+                                int64_t           & integerSectionSize,
+                                int64_t           & floatSectionSize,
+                                int64_t           & headerSize)
+    {
         std::ifstream myFile = std::ifstream(filename,
                                              std::ios::in |
                                              std::ifstream::binary);
@@ -1214,35 +1752,85 @@ namespace jiminy
             return result_t::ERROR_BAD_INPUT;
         }
 
-        FileDevice device(filename);
-        device.open(OpenMode::READ_ONLY);
-        std::vector<AbstractIODevice *> flows;
-        flows.push_back(&device);
+        return result_t::SUCCESS;
+    }
 
-        TelemetryRecorder::getData(header,
-                                   timestamps,
-                                   intData,
-                                   floatData,
-                                   flows,
-                                   integerSectionSize,
-                                   floatSectionSize,
-                                   headerSize);
+    result_t Engine::parseLogBinaryRaw(std::string                          const & filename,
+                                       std::vector<std::string>                   & header,
+                                       std::vector<float64_t>                     & timestamps,
+                                       std::vector<std::vector<int32_t> >         & intData,
+                                       std::vector<std::vector<float32_t> >       & floatData)
+    {
+        int64_t integerSectionSize;
+        int64_t floatSectionSize;
+        int64_t headerSize;
+        result_t returnCode = getLogBinaryLayout(
+            filename, integerSectionSize, floatSectionSize, headerSize);
 
-        return result_t::SUCCESS;
+        if (returnCode == result_t::SUCCESS)
+        {
+            FileDevice device(filename);
+            device.open(OpenMode::READ_ONLY);
+            std::vector<AbstractIODevice *> flows;
+            flows.push_back(&device);
+
+            TelemetryRecorder::getData(header,
+                                       timestamps,
+                                       intData,
+                                       floatData,
+                                       flows,
+                                       integerSectionSize,
+                                       floatSectionSize,
+                                       headerSize);
+        }
+
+        return returnCode;
+    }
+
+    result_t Engine::parseLogBinaryColumns(std::string              const & filename,
+                                           std::vector<std::string>       & header,
+                                           vectorN_t                      & timestamps,
+                                           intDataMatrix_t                & intData,
+                                           floatDataMatrix_t              & floatData)
+    {
+        int64_t integerSectionSize;
+        int64_t floatSectionSize;
+        int64_t headerSize;
+        result_t returnCode = getLogBinaryLayout(
+            filename, integerSectionSize, floatSectionSize, headerSize);
+
+        if (returnCode == result_t::SUCCESS)
+        {
+            FileDevice device(filename);
+            device.open(OpenMode::READ_ONLY);
+            std::vector<AbstractIODevice *> flows;
+            flows.push_back(&device);
+
+            returnCode = TelemetryRecorder::getDataColumns(header,
+                                                           timestamps,
+                                                           intData,
+                                                           floatData,
+                                                           flows,
+                                                           integerSectionSize,
+                                                           floatSectionSize,
+                                                           headerSize);
+        }
+
+        return returnCode;
     }
 
     result_t Engine::parseLogBinary(std::string              const & filename,
                                     std::vector<std::string>       & header,
                                     matrixN_t                      & logData)
     {
-        std::vector<float64_t> timestamps;
-        std::vector<std::vector<int32_t> > intData;
-        std::vector<std::vector<float32_t> > floatData;
-        result_t returnCode = parseLogBinaryRaw(
+        vectorN_t timestamps;
+        intDataMatrix_t intData;
+        floatDataMatrix_t floatData;
+        result_t returnCode = parseLogBinaryColumns(
             filename, header, timestamps, intData, floatData);
         if (returnCode == result_t::SUCCESS)
         {
-            logDataRawToEigenMatrix(timestamps, intData, floatData, logData);
+            logDataColumnsToEigenMatrix(timestamps, intData, floatData, logData);
         }
         return returnCode;
     }
@@ -1308,13 +1896,9 @@ namespace jiminy
         // Compute the dynamics
         vectorN_t a = Engine::aba(model_->pncModel_, model_->pncData_, q, v, u, fext);
 
-        float64_t dt = t - stepperStateLast_.t;
-        vectorN_t qDot(model_->nq());
-        computePositionDerivative(model_->pncModel_, q, v, qDot, dt);
-
         // Fill up dxdt
         dxdt.resize(model_->nx());
-        dxdt.head(model_->nq()) = qDot;
+        computePositionDerivative(model_->pncModel_, q, v, dxdt.head(model_->nq()));
         dxdt.tail(model_->nv()) = a;
     }
 
@@ -1341,6 +1925,7 @@ namespace jiminy
         // /* /!\ Note that the contact dynamics depends only on kinematics data. /!\ */
 
         contactOptions_t const * const contactOptions_ = &engineOptions_->contacts;
+        contactParameters_t const & contactParameters = contactParameters_;
 
         matrix3_t const & tformFrameRot = model_->pncData_.oMf[frameId].rotation();
         vector3_t const & posFrame = model_->pncData_.oMf[frameId].translation();
@@ -1366,9 +1951,9 @@ namespace jiminy
             float64_t fextNormal = 0.0;
             if(vDepth < 0.0)
             {
-                fextNormal -= contactOptions_->damping * vDepth;
+                fextNormal -= contactParameters.damping * vDepth;
             }
-            fextNormal -= contactOptions_->stiffness * depth;
+            fextNormal -= contactParameters.stiffness * depth;
             fextInWorld = fextNormal * nGround;
 
             // Compute friction forces
@@ -1380,18 +1965,18 @@ namespace jiminy
             {
                 if(vNorm < 1.5 * contactOptions_->dryFrictionVelEps)
                 {
-                    frictionCoeff = -2.0 * (contactOptions_->frictionDry -
-                        contactOptions_->frictionViscous) * (vNorm / contactOptions_->dryFrictionVelEps)
-                        + 3.0 * contactOptions_->frictionDry - 2.0*contactOptions_->frictionViscous;
+                    frictionCoeff = -2.0 * (contactParameters.frictionDry -
+                        contactParameters.frictionViscous) * (vNorm / contactOptions_->dryFrictionVelEps)
+                        + 3.0 * contactParameters.frictionDry - 2.0*contactParameters.frictionViscous;
                 }
                 else
                 {
-                    frictionCoeff = contactOptions_->frictionViscous;
+                    frictionCoeff = contactParameters.frictionViscous;
                 }
             }
             else
             {
-                frictionCoeff = contactOptions_->frictionDry *
+                frictionCoeff = contactParameters.frictionDry *
                     (vNorm / contactOptions_->dryFrictionVelEps);
             }
             float64_t fextTangential = frictionCoeff * fextNormal;
@@ -1424,101 +2009,57 @@ namespace jiminy
         // Compute the user-defined internal dynamics
         controller_->internalDynamics(t, q, v, u);
 
-        // Enforce the position limit (do not support spherical joints)
-        if (model_->mdlOptions_->joints.enablePositionLimit)
+        // Enforce the position and velocity limits at once (do not support spherical joints)
+        Model::jointOptions_t const & mdlJointOptions = model_->mdlOptions_->joints;
+        if (!jointsLimitsVelocityIdx_.empty()
+         && (mdlJointOptions.enablePositionLimit || mdlJointOptions.enableVelocityLimit))
         {
             Engine::jointOptions_t const & engineJointOptions = engineOptions_->joints;
 
-            std::vector<int32_t> const & jointsModelIdx = model_->getRigidJointsModelIdx();
-            vectorN_t const & positionLimitMin = model_->getPositionLimitMin();
-            vectorN_t const & positionLimitMax = model_->getPositionLimitMax();
-            uint32_t jointIdxOffset = 0;
-            for (uint32_t i = 0; i < jointsModelIdx.size(); i++)
+            // Gather the position and velocity of the joints
+            for (uint32_t i = 0; i < jointsLimitsVelocityIdx_.size(); i++)
             {
-                uint32_t const & jointPositionIdx = model_->pncModel_.joints[jointsModelIdx[i]].idx_q();
-                uint32_t const & jointVelocityIdx = model_->pncModel_.joints[jointsModelIdx[i]].idx_v();
-                uint32_t const & jointDof = model_->pncModel_.joints[jointsModelIdx[i]].nq();
-
-                for (uint32_t j = 0; j < jointDof; j++)
+                jointsLimitsPosition_[i] = q[jointsLimitsPositionIdx_[i]];
+                jointsLimitsVelocity_[i] = v[jointsLimitsVelocityIdx_[i]];
+            }
+            auto const qJoints = jointsLimitsPosition_.array();
+            auto const vJoints = jointsLimitsVelocity_.array();
+            auto jointsError = jointsLimitsError_.array();
+            auto jointsForce = jointsLimitsForce_.array();
+
+            /* The errors are signed and null within the bounds, so that the penalty forces
+               do not require any branching. Each one is blended and clamped independently. */
+            jointsLimitsTotalForce_.setZero();
+            if (mdlJointOptions.enablePositionLimit)
+            {
+                auto const qJointsMin = model_->getPositionLimitMin().array();
+                auto const qJointsMax = model_->getPositionLimitMax().array();
+                jointsError = qJoints - qJoints.min(qJointsMax).max(qJointsMin);
+                jointsForce = - engineJointOptions.boundStiffness * jointsError
+                              - engineJointOptions.boundDamping * (jointsError > 0.0).select(
+                                    vJoints.max(0.0), (jointsError < 0.0).select(vJoints.min(0.0), 0.0));
+                if (engineJointOptions.boundTransitionEps > EPS)
                 {
-                    float64_t const & qJoint = q(jointPositionIdx + j);
-                    float64_t const & vJoint = v(jointVelocityIdx + j);
-                    float64_t const & qJointMin = positionLimitMin[jointIdxOffset];
-                    float64_t const & qJointMax = positionLimitMax[jointIdxOffset];
-
-                    float64_t forceJoint = 0;
-                    float64_t qJointError = 0;
-                    if (qJoint > qJointMax)
-                    {
-                        qJointError = qJoint - qJointMax;
-                        float64_t damping = -engineJointOptions.boundDamping * std::max(vJoint, 0.0);
-                        forceJoint = -engineJointOptions.boundStiffness * qJointError + damping;
-                    }
-                    else if (qJoint < qJointMin)
-                    {
-                        qJointError = qJointMin - qJoint;
-                        float64_t damping = -engineJointOptions.boundDamping * std::min(vJoint, 0.0);
-                        forceJoint = engineJointOptions.boundStiffness * qJointError + damping;
-                    }
-
-                    if (engineJointOptions.boundTransitionEps > EPS)
-                    {
-                        float64_t blendingFactor = qJointError / engineJointOptions.boundTransitionEps;
-                        float64_t blendingLaw = std::tanh(2 * blendingFactor);
-                        forceJoint *= blendingLaw;
-                    }
-
-                    u[jointVelocityIdx + j] += clamp(forceJoint, -1e5, 1e5);
-
-                    jointIdxOffset += 1;
+                    jointsForce *= (2.0 / engineJointOptions.boundTransitionEps * jointsError.abs()).tanh();
                 }
+                jointsLimitsTotalForce_.array() += jointsForce.min(1e5).max(-1e5);
             }
-        }
-
-        // Enforce the velocity limit (do not support spherical joints)
-        if (model_->mdlOptions_->joints.enableVelocityLimit)
-        {
-            Engine::jointOptions_t const & engineJointOptions = engineOptions_->joints;
-
-            std::vector<int32_t> const & jointsModelIdx = model_->getRigidJointsModelIdx();
-            vectorN_t const & velocityLimitMax = model_->getVelocityLimit();
-
-            uint32_t jointIdxOffset = 0;
-            for (uint32_t i = 0; i < jointsModelIdx.size(); i++)
+            if (mdlJointOptions.enableVelocityLimit)
             {
-                uint32_t const & jointVelocityIdx = model_->pncModel_.joints[jointsModelIdx[i]].idx_v();
-                uint32_t const & jointDof = model_->pncModel_.joints[jointsModelIdx[i]].nq();
-
-                for (uint32_t j = 0; j < jointDof; j++)
+                auto const vJointsMax = model_->getVelocityLimit().array();
+                jointsError = vJoints - vJoints.min(vJointsMax).max(-vJointsMax);
+                jointsForce = - engineJointOptions.boundDamping * jointsError;
+                if (engineJointOptions.boundTransitionEps > EPS)
                 {
-                    float64_t const & vJoint = v(jointVelocityIdx + j);
-                    float64_t const & vJointMin = -velocityLimitMax[jointIdxOffset];
-                    float64_t const & vJointMax = velocityLimitMax[jointIdxOffset];
-
-                    float64_t forceJoint = 0.0;
-                    float64_t vJointError = 0.0;
-                    if (vJoint > vJointMax)
-                    {
-                        vJointError = vJoint - vJointMax;
-                        forceJoint = -engineJointOptions.boundDamping * vJointError;
-                    }
-                    else if (vJoint < vJointMin)
-                    {
-                        vJointError = vJointMin - vJoint;
-                        forceJoint = engineJointOptions.boundDamping * vJointError;
-                    }
-
-                    if (engineJointOptions.boundTransitionEps > EPS)
-                    {
-                        float64_t blendingFactor = vJointError / engineJointOptions.boundTransitionEps;
-                        float64_t blendingLaw = std::tanh(2 * blendingFactor);
-                        forceJoint *= blendingLaw;
-                    }
-
-                    u[jointVelocityIdx + j] += clamp(forceJoint, -1e5, 1e5);
-
-                    jointIdxOffset += 1;
+                    jointsForce *= (2.0 / engineJointOptions.boundTransitionEps * jointsError.abs()).tanh();
                 }
+                jointsLimitsTotalForce_.array() += jointsForce.min(1e5).max(-1e5);
+            }
+
+            // Scatter the penalty forces
+            for (uint32_t i = 0; i < jointsLimitsVelocityIdx_.size(); i++)
+            {
+                u[jointsLimitsVelocityIdx_[i]] += jointsLimitsTotalForce_[i];
             }
         }
 
@@ -0,0 +1,483 @@
+#include <algorithm>
+
+#include "jiminy/core/AbstractSensor.h"
+#include "jiminy/core/ControllerFunctor.h"
+#include "jiminy/core/EngineBatch.h"
+
+
+namespace jiminy
+{
+    using commandFunctor_t = std::function<void(float64_t        const & /*t*/,
+                                                vectorN_t        const & /*q*/,
+                                                vectorN_t        const & /*v*/,
+                                                sensorsDataMap_t const & /*sensorsData*/,
+                                                vectorN_t              & /*u*/)>;
+
+    EngineBatch::EngineBatch(void) :
+    isInitialized_(false),
+    nx_(0),
+    nu_(0),
+    sensorsDataSize_(0),
+    engines_(),
+    commands_(),
+    sensorsData_(),
+    workers_(),
+    workersMutex_(),
+    jobCondition_(),
+    doneCondition_(),
+    job_(nullptr),
+    jobCounter_(0),
+    numWorkersBusy_(0),
+    isStopping_(false),
+    jobResults_()
+    {
+        // Empty.
+    }
+
+    EngineBatch::~EngineBatch(void)
+    {
+        stopWorkers();
+    }
+
+    result_t EngineBatch::initialize(std::vector<std::shared_ptr<Model> > const & models,
+                                     uint32_t                             const & numThreads)
+    {
+        result_t returnCode = result_t::SUCCESS;
+
+        if (models.empty())
+        {
+            std::cout << "Error - EngineBatch::initialize - The list of models must not be empty." << std::endl;
+            return result_t::ERROR_BAD_INPUT;
+        }
+
+        for (auto const & model : models)
+        {
+            if (!model->getIsInitialized())
+            {
+                std::cout << "Error - EngineBatch::initialize - Some models are not initialized." << std::endl;
+                return result_t::ERROR_INIT_FAILED;
+            }
+            if (model->nx() != models[0]->nx()
+             || model->getMotorsNames().size() != models[0]->getMotorsNames().size())
+            {
+                std::cout << "Error - EngineBatch::initialize - The models must have the same number of states and motors." << std::endl;
+                return result_t::ERROR_BAD_INPUT;
+            }
+            if (std::count(models.begin(), models.end(), model) > 1)
+            {
+                std::cout << "Error - EngineBatch::initialize - Every engine must have its own model." << std::endl;
+                return result_t::ERROR_BAD_INPUT;
+            }
+        }
+
+        // Stop the workers of a previous initialization, if any
+        stopWorkers();
+        isInitialized_ = false;
+
+        nx_ = models[0]->nx();
+        nu_ = models[0]->getMotorsNames().size();
+        sensorsDataSize_ = 0;
+
+        /* The buffers of commands must be allocated once and for all,
+           since the controllers are referring to them. */
+        engines_.clear();
+        sensorsData_.clear();
+        commands_.assign(models.size(), vectorN_t::Zero(nu_));
+        sensorsData_.resize(models.size());
+
+        for (uint32_t i = 0; i < models.size(); i++)
+        {
+            vectorN_t const * command = &commands_[i];
+            commandFunctor_t commandFct = [command](float64_t        const & t,
+                                                    vectorN_t        const & q,
+                                                    vectorN_t        const & v,
+                                                    sensorsDataMap_t const & sensorsData,
+                                                    vectorN_t              & u)
+                                          {
+                                              u = *command;
+                                          };
+            commandFunctor_t internalDynamicsFct = [](float64_t        const & t,
+                                                      vectorN_t        const & q,
+                                                      vectorN_t        const & v,
+                                                      sensorsDataMap_t const & sensorsData,
+                                                      vectorN_t              & u)
+                                                   {
+                                                       // Empty on purpose.
+                                                   };
+            auto controller = std::make_shared<ControllerFunctor<commandFunctor_t, commandFunctor_t> >(
+                std::move(commandFct), std::move(internalDynamicsFct));
+
+            if (returnCode == result_t::SUCCESS)
+            {
+                returnCode = controller->initialize(models[i]);
+            }
+
+            /* Each engine draws its own sequence of random numbers, so that the
+               simulations are independent and do not depend on the workers. */
+            if (returnCode == result_t::SUCCESS)
+            {
+                auto engine = std::make_shared<Engine>();
+                engine->setRandomStreamIdx(i);
+                Engine::callbackFunctor_t callbackFct = [](float64_t const & t,
+                                                           vectorN_t const & x) -> bool_t
+                                                        {
+                                                            return true;
+                                                        };
+                returnCode = engine->initialize(models[i], controller, std::move(callbackFct));
+                engines_.push_back(std::move(engine));
+            }
+        }
+
+        // Spawn the worker threads. The calling thread is used directly if there is only one.
+        if (returnCode == result_t::SUCCESS)
+        {
+            uint32_t numWorkers = numThreads;
+            if (numWorkers == 0U)
+            {
+                numWorkers = std::max(std::thread::hardware_concurrency(), 1U);
+            }
+            numWorkers = std::min(numWorkers, static_cast<uint32_t>(engines_.size()));
+
+            isStopping_ = false;
+            jobResults_.assign(numWorkers, result_t::SUCCESS);
+            if (numWorkers > 1U)
+            {
+                for (uint32_t i = 0; i < numWorkers; i++)
+                {
+                    workers_.emplace_back(&EngineBatch::workerLoop, this, i);
+                }
+            }
+
+            isInitialized_ = true;
+        }
+
+        return returnCode;
+    }
+
+    void EngineBatch::stopWorkers(void)
+    {
+        {
+            std::lock_guard<std::mutex> lock(workersMutex_);
+            isStopping_ = true;
+        }
+        jobCondition_.notify_all();
+        for (std::thread & worker : workers_)
+        {
+            worker.join();
+        }
+        workers_.clear();
+        jobCounter_ = 0U;
+    }
+
+    void EngineBatch::workerLoop(uint32_t const & workerIdx)
+    {
+        uint32_t const numWorkers = jobResults_.size();
+        uint32_t const idxStart = (workerIdx * engines_.size()) / numWorkers;
+        uint32_t const idxEnd = ((workerIdx + 1) * engines_.size()) / numWorkers;
+
+        uint64_t jobCounterLast = 0U;
+        while (true)
+        {
+            std::function<result_t(uint32_t const &)> const * job;
+            {
+                std::unique_lock<std::mutex> lock(workersMutex_);
+                jobCondition_.wait(lock, [this, &jobCounterLast]()
+                                         {
+                                             return isStopping_ || jobCounter_ != jobCounterLast;
+                                         });
+                if (isStopping_)
+                {
+                    return;
+                }
+                jobCounterLast = jobCounter_;
+                job = job_;
+            }
+
+            result_t returnCode = result_t::SUCCESS;
+            for (uint32_t i = idxStart; i < idxEnd; i++)
+            {
+                result_t const returnCodeEngine = (*job)(i);
+                if (returnCode == result_t::SUCCESS)
+                {
+                    returnCode = returnCodeEngine;
+                }
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(workersMutex_);
+                jobResults_[workerIdx] = returnCode;
+                if (--numWorkersBusy_ == 0U)
+                {
+                    doneCondition_.notify_one();
+                }
+            }
+        }
+    }
+
+    result_t EngineBatch::runJob(std::function<result_t(uint32_t const & /*idx*/)> const & job)
+    {
+        if (workers_.empty())
+        {
+            result_t returnCode = result_t::SUCCESS;
+            for (uint32_t i = 0; i < engines_.size(); i++)
+            {
+                result_t const returnCodeEngine = job(i);
+                if (returnCode == result_t::SUCCESS)
+                {
+                    returnCode = returnCodeEngine;
+                }
+            }
+            return returnCode;
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(workersMutex_);
+            job_ = &job;
+            numWorkersBusy_ = workers_.size();
+            ++jobCounter_;
+            jobCondition_.notify_all();
+            doneCondition_.wait(lock, [this]()
+                                      {
+                                          return numWorkersBusy_ == 0U;
+                                      });
+            job_ = nullptr;
+        }
+
+        for (result_t const & returnCode : jobResults_)
+        {
+            if (returnCode != result_t::SUCCESS)
+            {
+                return returnCode;
+            }
+        }
+        return result_t::SUCCESS;
+    }
+
+    result_t EngineBatch::start(Eigen::Ref<batchMatrix_t const> const & xInit,
+                                bool_t                          const & isStateTheoretical,
+                                bool_t                          const & resetRandomNumbers)
+    {
+        if (!isInitialized_)
+        {
+            std::cout << "Error - EngineBatch::start - The batch is not initialized." << std::endl;
+            return result_t::ERROR_INIT_FAILED;
+        }
+
+        if (static_cast<uint32_t>(xInit.rows()) != engines_.size())
+        {
+            std::cout << "Error - EngineBatch::start - The number of initial states must match the number of engines." << std::endl;
+            return result_t::ERROR_BAD_INPUT;
+        }
+
+        /* The randomized parameters of every engine are sampled by its own start, from its
+           own generators, so that they do not depend on the way the engines are distributed
+           between the workers, and are the same as for the engine alone. */
+        result_t returnCode = runJob(
+            [this, &xInit, &isStateTheoretical, &resetRandomNumbers](uint32_t const & idx) -> result_t
+            {
+                commands_[idx].setZero();
+                return engines_[idx]->start(xInit.row(idx).transpose(), isStateTheoretical, resetRandomNumbers);
+            });
+
+        /* Gather the flat sensors data of every engine. The models are locked
+           while the simulation is running, so that the layout cannot change. */
+        if (returnCode == result_t::SUCCESS)
+        {
+            for (uint32_t i = 0; i < engines_.size(); i++)
+            {
+                sensorsData_[i] = &engines_[i]->getModel().getSensorsDataFlat();
+                uint32_t const sensorsDataSize = sensorsData_[i]->size();
+
+                if (i == 0)
+                {
+                    sensorsDataSize_ = sensorsDataSize;
+                }
+                else if (sensorsDataSize != sensorsDataSize_)
+                {
+                    std::cout << "Error - EngineBatch::start - The models must have the same sensors." << std::endl;
+                    returnCode = result_t::ERROR_BAD_INPUT;
+                    break;
+                }
+            }
+        }
+
+        if (returnCode != result_t::SUCCESS)
+        {
+            stop();
+        }
+
+        return returnCode;
+    }
+
+    result_t EngineBatch::step(Eigen::Ref<batchMatrix_t const> const & uCommand,
+                               float64_t                       const & stepSize,
+                               Eigen::Ref<batchMatrix_t>               x,
+                               Eigen::Ref<batchMatrix_t>               sensorsData)
+    {
+        batchMatrix_t t;
+        return stepMultiple(uCommand, 1U, stepSize, t, x, sensorsData);
+    }
+
+    result_t EngineBatch::stepMultiple(Eigen::Ref<batchMatrix_t const> const & uCommand,
+                                       uint32_t                        const & numSteps,
+                                       float64_t                       const & stepSize,
+                                       Eigen::Ref<batchMatrix_t>               t,
+                                       Eigen::Ref<batchMatrix_t>               x,
+                                       Eigen::Ref<batchMatrix_t>               sensorsData)
+    {
+        if (!isInitialized_)
+        {
+            std::cout << "Error - EngineBatch::stepMultiple - The batch is not initialized." << std::endl;
+            return result_t::ERROR_INIT_FAILED;
+        }
+
+        if (numSteps == 0U)
+        {
+            std::cout << "Error - EngineBatch::stepMultiple - The number of steps must be strictly positive." << std::endl;
+            return result_t::ERROR_BAD_INPUT;
+        }
+
+        bool_t const isCommandHeld = (static_cast<uint32_t>(uCommand.cols()) == nu_);
+        if (static_cast<uint32_t>(uCommand.rows()) != engines_.size()
+         || (!isCommandHeld && static_cast<uint32_t>(uCommand.cols()) != numSteps * nu_))
+        {
+            std::cout << "Error - EngineBatch::stepMultiple - The commands must be of size (number of engines, number of motors) "\
+                         "or (number of engines, number of steps * number of motors)." << std::endl;
+            return result_t::ERROR_BAD_INPUT;
+        }
+
+        bool_t const isTimeRequired = (t.size() > 0);
+        if (isTimeRequired && (static_cast<uint32_t>(t.rows()) != engines_.size()
+                            || static_cast<uint32_t>(t.cols()) != numSteps))
+        {
+            std::cout << "Error - EngineBatch::stepMultiple - The time buffer must be of size (number of engines, number of steps)." << std::endl;
+            return result_t::ERROR_BAD_INPUT;
+        }
+
+        bool_t const isStateRequired = (x.size() > 0);
+        if (isStateRequired && (static_cast<uint32_t>(x.rows()) != engines_.size()
+                             || static_cast<uint32_t>(x.cols()) != numSteps * nx_))
+        {
+            std::cout << "Error - EngineBatch::stepMultiple - The state buffer must be of size (number of engines, number of steps * nx)." << std::endl;
+            return result_t::ERROR_BAD_INPUT;
+        }
+
+        bool_t const isSensorsDataRequired = (sensorsData.size() > 0);
+        if (isSensorsDataRequired && (static_cast<uint32_t>(sensorsData.rows()) != engines_.size()
+                                   || static_cast<uint32_t>(sensorsData.cols()) != numSteps * sensorsDataSize_))
+        {
+            std::cout << "Error - EngineBatch::stepMultiple - The sensors data buffer must be of size (number of engines, number of steps * sensors data size)." << std::endl;
+            return result_t::ERROR_BAD_INPUT;
+        }
+
+        return runJob(
+            [this, &uCommand, &numSteps, &stepSize, &t, &x, &sensorsData,
+             &isCommandHeld, &isTimeRequired, &isStateRequired, &isSensorsDataRequired](
+                uint32_t const & idx) -> result_t
+            {
+                result_t returnCode = result_t::SUCCESS;
+
+                for (uint32_t k = 0; k < numSteps; k++)
+                {
+                    if (isCommandHeld)
+                    {
+                        if (k == 0)
+                        {
+                            commands_[idx] = uCommand.row(idx).transpose();
+                        }
+                    }
+                    else
+                    {
+                        commands_[idx] = uCommand.row(idx).segment(k * nu_, nu_).transpose();
+                    }
+
+                    returnCode = engines_[idx]->step(stepSize);
+                    if (returnCode != result_t::SUCCESS)
+                    {
+                        break;
+                    }
+
+                    stepperState_t const & stepperState = engines_[idx]->getStepperState();
+                    if (isTimeRequired)
+                    {
+                        t(idx, k) = stepperState.t;
+                    }
+                    if (isStateRequired)
+                    {
+                        x.row(idx).segment(k * nx_, nx_) = stepperState.x.transpose();
+                    }
+                    if (isSensorsDataRequired)
+                    {
+                        getSensorsData(idx, sensorsData.row(idx).data() + k * sensorsDataSize_);
+                    }
+                }
+
+                return returnCode;
+            });
+    }
+
+    void EngineBatch::stop(void)
+    {
+        for (auto & engine : engines_)
+        {
+            engine->stop();
+        }
+    }
+
+    result_t EngineBatch::setDomainRandomization(std::shared_ptr<DomainRandomization const> const & domainRandomization)
+    {
+        if (!isInitialized_)
+        {
+            std::cout << "Error - EngineBatch::setDomainRandomization - The batch is not initialized." << std::endl;
+            return result_t::ERROR_INIT_FAILED;
+        }
+
+        result_t returnCode = result_t::SUCCESS;
+
+        for (auto & engine : engines_)
+        {
+            if (returnCode == result_t::SUCCESS)
+            {
+                returnCode = engine->setDomainRandomization(domainRandomization);
+            }
+        }
+
+        return returnCode;
+    }
+
+    void EngineBatch::getSensorsData(uint32_t const & idx,
+                                     float64_t      * sensorsData) const
+    {
+        Eigen::Map<vectorN_t>(sensorsData, sensorsData_[idx]->size()) = *sensorsData_[idx];
+    }
+
+    bool_t EngineBatch::getIsInitialized(void) const
+    {
+        return isInitialized_;
+    }
+
+    uint32_t EngineBatch::size(void) const
+    {
+        return engines_.size();
+    }
+
+    Engine & EngineBatch::getEngine(uint32_t const & idx) const
+    {
+        return *engines_.at(idx);
+    }
+
+    uint32_t const & EngineBatch::nx(void) const
+    {
+        return nx_;
+    }
+
+    uint32_t const & EngineBatch::nu(void) const
+    {
+        return nu_;
+    }
+
+    uint32_t const & EngineBatch::getSensorsDataSize(void) const
+    {
+        return sensorsDataSize_;
+    }
+}
@@ -0,0 +1,312 @@
+#include "jiminy/core/AbstractSensor.h"
+#include "jiminy/core/Model.h"
+#include "jiminy/core/Environment.h"
+
+
+namespace jiminy
+{
+    result_t AbstractRewardTerm::initialize(Model const & model)
+    {
+        return result_t::SUCCESS;
+    }
+
+    TrackingReward::TrackingReward(uint32_t  const & startIdx,
+                                   vectorN_t const & target) :
+    AbstractRewardTerm(),
+    startIdx_(startIdx),
+    target_(target)
+    {
+        // Empty.
+    }
+
+    result_t TrackingReward::initialize(Model const & model)
+    {
+        if (startIdx_ + static_cast<uint32_t>(target_.size()) > model.nx())
+        {
+            std::cout << "Error - TrackingReward::initialize - The target is inconsistent with the dimension of the state." << std::endl;
+            return result_t::ERROR_BAD_INPUT;
+        }
+
+        return result_t::SUCCESS;
+    }
+
+    float64_t TrackingReward::compute(Model          const & model,
+                                      stepperState_t const & stepperState,
+                                      float64_t      const & dt) const
+    {
+        return - (stepperState.x.segment(startIdx_, target_.size()) - target_).squaredNorm();
+    }
+
+    void TrackingReward::setTarget(vectorN_t const & target)
+    {
+        // The size cannot change, since it has already been checked against the model
+        if (target.size() == target_.size())
+        {
+            target_ = target;
+        }
+        else
+        {
+            std::cout << "Error - TrackingReward::setTarget - The size of the target cannot change." << std::endl;
+        }
+    }
+
+    float64_t TorqueReward::compute(Model          const & model,
+                                    stepperState_t const & stepperState,
+                                    float64_t      const & dt) const
+    {
+        return - stepperState.uMotor.squaredNorm();
+    }
+
+    EnergyReward::EnergyReward(void) :
+    AbstractRewardTerm(),
+    motorsVelocityIdx_()
+    {
+        // Empty.
+    }
+
+    result_t EnergyReward::initialize(Model const & model)
+    {
+        motorsVelocityIdx_ = model.getMotorsVelocityIdx();
+        return result_t::SUCCESS;
+    }
+
+    float64_t EnergyReward::compute(Model          const & model,
+                                    stepperState_t const & stepperState,
+                                    float64_t      const & dt) const
+    {
+        // The velocity of the motors is evaluated at the end of the step
+        float64_t power = 0.0;
+        for (uint32_t i = 0; i < motorsVelocityIdx_.size(); i++)
+        {
+            float64_t const & vMotor = stepperState.x[model.nq() + motorsVelocityIdx_[i]];
+            power += std::abs(stepperState.uMotor[i] * vMotor);
+        }
+        return - power * dt;
+    }
+
+    float64_t SurvivalReward::compute(Model          const & model,
+                                      stepperState_t const & stepperState,
+                                      float64_t      const & dt) const
+    {
+        return 1.0;
+    }
+
+    Environment::Environment(void) :
+    isInitialized_(false),
+    isReady_(false),
+    engine_(nullptr),
+    observationComponents_(),
+    rewardTerms_(),
+    terminationConditions_(),
+    observation_(),
+    observationSize_(0),
+    tPrev_(0.0)
+    {
+        // Empty.
+    }
+
+    result_t Environment::initialize(std::shared_ptr<Engine> const & engine)
+    {
+        if (!engine->getIsInitialized())
+        {
+            std::cout << "Error - Environment::initialize - The engine is not initialized." << std::endl;
+            return result_t::ERROR_INIT_FAILED;
+        }
+
+        engine_ = engine;
+        isInitialized_ = true;
+        isReady_ = false;
+
+        return result_t::SUCCESS;
+    }
+
+    result_t Environment::addObservationState(uint32_t const & startIdx,
+                                              uint32_t const & size)
+    {
+        observationComponents_.push_back({startIdx, size, std::string()});
+        isReady_ = false;
+        return result_t::SUCCESS;
+    }
+
+    result_t Environment::addObservationSensors(std::string const & sensorType)
+    {
+        if (sensorType.empty())
+        {
+            std::cout << "Error - Environment::addObservationSensors - The type of sensors must not be empty." << std::endl;
+            return result_t::ERROR_BAD_INPUT;
+        }
+
+        observationComponents_.push_back({0U, 0U, sensorType});
+        isReady_ = false;
+        return result_t::SUCCESS;
+    }
+
+    result_t Environment::addRewardTerm(std::shared_ptr<AbstractRewardTerm> const & rewardTerm,
+                                        float64_t                            const & weight)
+    {
+        rewardTerms_.emplace_back(rewardTerm, weight);
+        isReady_ = false;
+        return result_t::SUCCESS;
+    }
+
+    result_t Environment::addTerminationCondition(std::shared_ptr<AbstractTerminationCondition> const & condition)
+    {
+        terminationConditions_.push_back(condition->clone());
+        isReady_ = false;
+        return result_t::SUCCESS;
+    }
+
+    void Environment::clear(void)
+    {
+        observationComponents_.clear();
+        rewardTerms_.clear();
+        terminationConditions_.clear();
+        observation_.resize(0);
+        observationSize_ = 0;
+        isReady_ = false;
+    }
+
+    result_t Environment::reset(void)
+    {
+        result_t returnCode = result_t::SUCCESS;
+
+        if (!isInitialized_)
+        {
+            std::cout << "Error - Environment::reset - The environment is not initialized." << std::endl;
+            return result_t::ERROR_INIT_FAILED;
+        }
+
+        isReady_ = false;
+
+        Model const & model = engine_->getModel();
+
+        // Resolve the observation components
+        observationSize_ = 0;
+        for (observationComponent_t & component : observationComponents_)
+        {
+            if (component.sensorType.empty())
+            {
+                if (component.startIdx + component.size > model.nx())
+                {
+                    std::cout << "Error - Environment::reset - A segment of the observation is out of the state." << std::endl;
+                    returnCode = result_t::ERROR_BAD_INPUT;
+                    break;
+                }
+            }
+            else
+            {
+                if (model.getSensorsDataSegment(component.sensorType, component.startIdx, component.size) != result_t::SUCCESS)
+                {
+                    std::cout << "Error - Environment::reset - No sensor of type '" << component.sensorType << "'." << std::endl;
+                    returnCode = result_t::ERROR_BAD_INPUT;
+                    break;
+                }
+            }
+            observationSize_ += component.size;
+        }
+        // Reallocate the observation only if its size changed
+        if (static_cast<uint32_t>(observation_.size()) != observationSize_)
+        {
+            observation_.resize(observationSize_);
+        }
+        observation_.setZero();
+
+        // Resolve the reward terms and termination conditions
+        if (returnCode == result_t::SUCCESS)
+        {
+            for (auto const & rewardTerm : rewardTerms_)
+            {
+                returnCode = rewardTerm.first->initialize(model);
+                if (returnCode != result_t::SUCCESS)
+                {
+                    break;
+                }
+            }
+        }
+
+        if (returnCode == result_t::SUCCESS)
+        {
+            for (auto const & condition : terminationConditions_)
+            {
+                returnCode = condition->initialize(model);
+                if (returnCode != result_t::SUCCESS)
+                {
+                    break;
+                }
+            }
+        }
+
+        if (returnCode == result_t::SUCCESS)
+        {
+            tPrev_ = engine_->getStepperState().t;
+            isReady_ = true;
+        }
+
+        return returnCode;
+    }
+
+    result_t Environment::compute(float64_t & reward,
+                                  bool_t    & isDone)
+    {
+        if (!isReady_)
+        {
+            std::cout << "Error - Environment::compute - The environment must be reset first." << std::endl;
+            return result_t::ERROR_INIT_FAILED;
+        }
+
+        Model const & model = engine_->getModel();
+        stepperState_t const & stepperState = engine_->getStepperState();
+
+        // Assemble the observation
+        vectorN_t const & sensorsData = model.getSensorsDataFlat();
+        float64_t * observationIt = observation_.data();
+        for (observationComponent_t const & component : observationComponents_)
+        {
+            vectorN_t const & source = component.sensorType.empty() ? stepperState.x : sensorsData;
+            Eigen::Map<vectorN_t>(observationIt, component.size) = source.segment(component.startIdx, component.size);
+            observationIt += component.size;
+        }
+
+        // Compute the reward over the elapsed time
+        float64_t const dt = stepperState.t - tPrev_;
+        reward = 0.0;
+        for (auto const & rewardTerm : rewardTerms_)
+        {
+            reward += rewardTerm.second * rewardTerm.first->compute(model, stepperState, dt);
+        }
+        tPrev_ = stepperState.t;
+
+        // Check the termination conditions
+        isDone = false;
+        for (auto const & condition : terminationConditions_)
+        {
+            if (condition->isTriggered(model, stepperState.t, stepperState.x))
+            {
+                isDone = true;
+                break;
+            }
+        }
+
+        return result_t::SUCCESS;
+    }
+
+    vectorN_t const & Environment::getObservation(void) const
+    {
+        return observation_;
+    }
+
+    uint32_t const & Environment::getObservationSize(void) const
+    {
+        return observationSize_;
+    }
+
+    bool_t const & Environment::getIsInitialized(void) const
+    {
+        return isInitialized_;
+    }
+
+    Engine & Environment::getEngine(void) const
+    {
+        return *engine_;
+    }
+}
@@ -1,8 +1,26 @@
 
+#include <cstdio>
+#include <iterator>
+#include <algorithm>
 #include <fstream>
+#include <sstream>
+#include <thread>
+#include <functional>
 #include <exception>
 
+#ifndef _WIN32
+#include <unistd.h>
+#else
+#include <process.h>
+#endif
+
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/vector.hpp>
+
 #include "pinocchio/parsers/urdf.hpp"
+#include "pinocchio/serialization/model.hpp"
 #include "pinocchio/algorithm/kinematics.hpp"
 #include "pinocchio/algorithm/frames.hpp"
 
@@ -14,13 +32,208 @@
 
 namespace jiminy
 {
+    std::string const MODEL_CACHE_MAGIC_NUMBER("jiminy_model_description");
+    uint32_t const MODEL_CACHE_VERSION = 1U;
+
+    int64_t getProcessId(void)
+    {
+    #ifndef _WIN32
+        return static_cast<int64_t>(getpid());
+    #else
+        return static_cast<int64_t>(_getpid());
+    #endif
+    }
+
+    static result_t getDescriptionKey(std::string const & urdfPath,
+                                      bool_t      const & hasFreeflyer,
+                                      uint64_t          & key)
+    {
+        std::ifstream urdfFile(urdfPath.c_str(), std::ios::binary);
+        if (!urdfFile.good())
+        {
+            return result_t::ERROR_BAD_INPUT;
+        }
+        std::stringstream urdfContent;
+        urdfContent << urdfFile.rdbuf();
+
+        // FNV-1a hash, which does not depend on the standard library implementation
+        key = 14695981039346656037ULL;
+        for (char const & c : urdfContent.str() + (hasFreeflyer ? '1' : '0'))
+        {
+            key ^= static_cast<uint8_t>(c);
+            key *= 1099511628211ULL;
+        }
+
+        return result_t::SUCCESS;
+    }
+
+    ModelDescription::ModelDescription(void) :
+    urdfPath(),
+    hasFreeflyer(false),
+    pncModelRigid(),
+    rigidJointsNames(),
+    key(0U)
+    {
+        // Empty.
+    }
+
+    result_t ModelDescription::initialize(std::string const & urdfPathIn,
+                                          bool_t      const & hasFreeflyerIn,
+                                          std::string const & cachePath)
+    {
+        uint64_t keyIn;
+        if (getDescriptionKey(urdfPathIn, hasFreeflyerIn, keyIn) != result_t::SUCCESS)
+        {
+            std::cout << "Error - ModelDescription::initialize - The URDF file does not exist. Impossible to load it." << std::endl;
+            return result_t::ERROR_BAD_INPUT;
+        }
+
+        // Load the description from the cache if it is up-to-date
+        if (!cachePath.empty() && load(cachePath, urdfPathIn, hasFreeflyerIn) == result_t::SUCCESS)
+        {
+            return result_t::SUCCESS;
+        }
+
+        try
+        {
+            pinocchio::Model pncModel;
+            if (hasFreeflyerIn)
+            {
+                pinocchio::urdf::buildModel(urdfPathIn,
+                                            pinocchio::JointModelFreeFlyer(),
+                                            pncModel);
+            }
+            else
+            {
+                pinocchio::urdf::buildModel(urdfPathIn, pncModel);
+            }
+            pncModelRigid = pncModel;
+        }
+        catch (std::exception& e)
+        {
+            std::cout << "Error - ModelDescription::initialize - Something is wrong with the URDF. Impossible to build a model from it." << std::endl;
+            return result_t::ERROR_BAD_INPUT;
+        }
+
+        urdfPath = urdfPathIn;
+        hasFreeflyer = hasFreeflyerIn;
+
+        /* Get the list of joint names of the rigid model and
+           remove the 'universe' and 'root' if any, since they
+           are not actual joints. */
+        rigidJointsNames = pncModelRigid.names;
+        rigidJointsNames.erase(rigidJointsNames.begin()); // remove the 'universe'
+        if (hasFreeflyer)
+        {
+            rigidJointsNames.erase(rigidJointsNames.begin()); // remove the 'root'
+        }
+
+        key = keyIn;
+
+        // Generate the cache. Failing to do so is not an error, since it is only an optimization.
+        if (!cachePath.empty())
+        {
+            save(cachePath);
+        }
+
+        return result_t::SUCCESS;
+    }
+
+    result_t ModelDescription::save(std::string const & filename) const
+    {
+        /* Write in a temporary file first, then rename it, so that concurrent
+           processes never read a partially written cache. The temporary file is
+           specific to both the process and the thread, since the identifiers of
+           the threads are only unique within a process. */
+        std::string const filenameTmp = filename + ".tmp" + std::to_string(getProcessId())
+            + "_" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+
+        try
+        {
+            std::ofstream file(filenameTmp.c_str(), std::ios::binary | std::ios::trunc);
+            if (!file.good())
+            {
+                std::cout << "Error - ModelDescription::save - Impossible to open the file." << std::endl;
+                return result_t::ERROR_BAD_INPUT;
+            }
+
+            boost::archive::binary_oarchive archive(file);
+            archive << MODEL_CACHE_MAGIC_NUMBER << MODEL_CACHE_VERSION << key;
+            archive << urdfPath << hasFreeflyer << rigidJointsNames << pncModelRigid;
+        }
+        catch (std::exception const & e)
+        {
+            std::cout << "Error - ModelDescription::save - Impossible to serialize the description." << std::endl;
+            std::remove(filenameTmp.c_str());
+            return result_t::ERROR_GENERIC;
+        }
+
+        if (std::rename(filenameTmp.c_str(), filename.c_str()) != 0)
+        {
+            std::cout << "Error - ModelDescription::save - Impossible to write the file." << std::endl;
+            std::remove(filenameTmp.c_str());
+            return result_t::ERROR_GENERIC;
+        }
+
+        return result_t::SUCCESS;
+    }
+
+    result_t ModelDescription::load(std::string const & filename,
+                                    std::string const & urdfPathIn,
+                                    bool_t      const & hasFreeflyerIn)
+    {
+        uint64_t keyIn;
+        if (getDescriptionKey(urdfPathIn, hasFreeflyerIn, keyIn) != result_t::SUCCESS)
+        {
+            std::cout << "Error - ModelDescription::load - The URDF file does not exist." << std::endl;
+            return result_t::ERROR_BAD_INPUT;
+        }
+
+        std::ifstream file(filename.c_str(), std::ios::binary);
+        if (!file.good())
+        {
+            return result_t::ERROR_BAD_INPUT;
+        }
+
+        try
+        {
+            boost::archive::binary_iarchive archive(file);
+
+            // Check the header before reading anything else
+            std::string magicNumber;
+            uint32_t version;
+            uint64_t keyFile;
+            archive >> magicNumber >> version >> keyFile;
+            if (magicNumber != MODEL_CACHE_MAGIC_NUMBER || version != MODEL_CACHE_VERSION || keyFile != keyIn)
+            {
+                return result_t::ERROR_GENERIC;
+            }
+
+            // The URDF file may have been moved, so its path is not taken from the cache
+            std::string urdfPathFile;
+            archive >> urdfPathFile >> hasFreeflyer >> rigidJointsNames >> pncModelRigid;
+        }
+        catch (std::exception const & e)
+        {
+            return result_t::ERROR_GENERIC;
+        }
+
+        urdfPath = urdfPathIn;
+        key = keyIn;
+
+        return result_t::SUCCESS;
+    }
+
     Model::Model(void) :
     pncModel_(),
     pncData_(pncModel_),
-    pncModelRigidOrig_(),
-    pncDataRigidOrig_(pncModelRigidOrig_),
+    pncDataRigidOrig_(pncModel_),
     mdlOptions_(nullptr),
     contactForces_(),
+    sensorsFramesIdx_(),
+    sensorsFramesQuat_(),
+    sensorsFramesGyro_(),
+    sensorsFramesAccel_(),
     isInitialized_(false),
     isTelemetryConfigured_(false),
     urdfPath_(),
@@ -30,6 +243,8 @@ namespace jiminy
     motorsHolder_(),
     sensorsGroupHolder_(),
     sensorTelemetryOptions_(),
+    sensorsDataFlat_(),
+    sensorsDataSegments_(),
     contactFramesNames_(),
     contactFramesIdx_(),
     motorsNames_(),
@@ -47,7 +262,10 @@ namespace jiminy
     accelerationFieldNames_(),
     motorTorqueFieldNames_(),
     mutexLocal_(),
+    description_(std::make_shared<ModelDescription const>()),
     pncModelFlexibleOrig_(),
+    pncModelBiasedOrig_(),
+    isModelBiased_(false),
     motorsSharedHolder_(nullptr),
     sensorsSharedHolder_(),
     nq_(0),
@@ -67,10 +285,34 @@ namespace jiminy
     }
 
     result_t Model::initialize(std::string const & urdfPath,
-                               bool_t      const & hasFreeflyer)
+                               bool_t      const & hasFreeflyer,
+                               std::string const & cachePath)
+    {
+        auto description = std::make_shared<ModelDescription>();
+        result_t returnCode = description->initialize(urdfPath, hasFreeflyer, cachePath);
+
+        if (returnCode == result_t::SUCCESS)
+        {
+            returnCode = initialize(std::move(description));
+        }
+        else
+        {
+            isInitialized_ = false;
+        }
+
+        return returnCode;
+    }
+
+    result_t Model::initialize(std::shared_ptr<ModelDescription const> const & description)
     {
         result_t returnCode = result_t::SUCCESS;
 
+        if (!description || description->urdfPath.empty())
+        {
+            std::cout << "Error - Model::initialize - The description is not initialized." << std::endl;
+            return result_t::ERROR_INIT_FAILED;
+        }
+
         // Remove all sensors, if any
         motorsHolder_.clear();
         motorsSharedHolder_ = std::make_shared<MotorSharedDataHolder_t>();
@@ -78,27 +320,16 @@ namespace jiminy
         sensorsSharedHolder_.clear();
         sensorTelemetryOptions_.clear();
 
-        // Initialize the URDF model
-        returnCode = loadUrdfModel(urdfPath, hasFreeflyer);
+        // Share the description of the robot
+        description_ = description;
+        urdfPath_ = description_->urdfPath;
+        hasFreeflyer_ = description_->hasFreeflyer;
+        rigidJointsNames_ = description_->rigidJointsNames;
+        pncModel_ = description_->pncModelRigid;
+        pncDataRigidOrig_ = pinocchio::Data(description_->pncModelRigid);
+        pncModelBiasedOrig_.reset();
         isInitialized_ = true;
 
-        if (returnCode == result_t::SUCCESS)
-        {
-            // Backup the original model and data
-            pncModelRigidOrig_ = pncModel_;
-            pncDataRigidOrig_ = pinocchio::Data(pncModelRigidOrig_);
-
-            /* Get the list of joint names of the rigid model and
-               remove the 'universe' and 'root' if any, since they
-               are not actual joints. */
-            rigidJointsNames_ = pncModelRigidOrig_.names;
-            rigidJointsNames_.erase(rigidJointsNames_.begin()); // remove the 'universe'
-            if (hasFreeflyer)
-            {
-                rigidJointsNames_.erase(rigidJointsNames_.begin()); // remove the 'root'
-            }
-        }
-
         if (returnCode == result_t::SUCCESS)
         {
             // Create the flexible model
@@ -137,11 +368,19 @@ namespace jiminy
             }
         }
 
+        // Gather the frames required by the sensors, now that their proxies are up-to-date
+        refreshSensorsKinematicsProxies();
+        refreshSensorsDataProxies();
+
         // Reset the motors
         for (auto & motor : motorsHolder_)
         {
             motor->reset();
         }
+        if (!motorsHolder_.empty())
+        {
+            (*motorsHolder_.begin())->refreshBanks();
+        }
 
         // Reset the telemetry state
         isTelemetryConfigured_ = false;
@@ -490,6 +729,12 @@ namespace jiminy
             returnCode = sensor->attach(this, sensorsSharedHolder_.at(sensorType));
         }
 
+        if (returnCode == result_t::SUCCESS)
+        {
+            // Update the layout of the flat sensors data
+            refreshSensorsDataProxies();
+        }
+
         return returnCode;
     }
 
@@ -558,6 +803,9 @@ namespace jiminy
                 sensorsSharedHolder_.erase(sensorType);
                 sensorTelemetryOptions_.erase(sensorType);
             }
+
+            // Update the layout of the flat sensors data
+            refreshSensorsDataProxies();
         }
 
         return returnCode;
@@ -621,32 +869,43 @@ namespace jiminy
         {
             flexibleJointsNames_.clear();
             flexibleJointsModelIdx_.clear();
-            pncModelFlexibleOrig_ = pncModelRigidOrig_;
-            for(flexibleJointData_t const & flexibleJoint : mdlOptions_->dynamics.flexibilityConfig)
-            {
-                std::string const & jointName = flexibleJoint.jointName;
 
-                // Look if given joint exists in the joint list.
-                if(returnCode == result_t::SUCCESS)
+            // Without any flexibility, the flexible model is the rigid one, which is shared
+            pinocchio::Model const & pncModelRigidOrig = description_->pncModelRigid;
+            if (mdlOptions_->dynamics.flexibilityConfig.empty())
+            {
+                pncModelFlexibleOrig_ = std::shared_ptr<pinocchio::Model const>(description_, &pncModelRigidOrig);
+            }
+            else
+            {
+                auto pncModelFlexibleOrig = std::make_shared<pinocchio::Model>(pncModelRigidOrig);
+                for(flexibleJointData_t const & flexibleJoint : mdlOptions_->dynamics.flexibilityConfig)
                 {
-                    int32_t jointIdx;
-                    returnCode = getJointPositionIdx(pncModel_, jointName, jointIdx);
-                }
+                    std::string const & jointName = flexibleJoint.jointName;
 
-                // Add joints to model.
-                if(returnCode == result_t::SUCCESS)
-                {
-                    std::string newName =
-                        removeFieldnameSuffix(jointName, "Joint") + FLEXIBLE_JOINT_SUFFIX;
-                    flexibleJointsNames_.emplace_back(newName);
-                    insertFlexibilityInModel(pncModelFlexibleOrig_, jointName, newName); // Ignore return code, as check has already been done.
+                    // Look if given joint exists in the joint list.
+                    if(returnCode == result_t::SUCCESS)
+                    {
+                        int32_t jointIdx;
+                        returnCode = getJointPositionIdx(pncModelRigidOrig, jointName, jointIdx);
+                    }
+
+                    // Add joints to model.
+                    if(returnCode == result_t::SUCCESS)
+                    {
+                        std::string newName =
+                            removeFieldnameSuffix(jointName, "Joint") + FLEXIBLE_JOINT_SUFFIX;
+                        flexibleJointsNames_.emplace_back(newName);
+                        insertFlexibilityInModel(*pncModelFlexibleOrig, jointName, newName); // Ignore return code, as check has already been done.
+                    }
                 }
+                pncModelFlexibleOrig_ = std::move(pncModelFlexibleOrig);
             }
         }
 
         if (returnCode == result_t::SUCCESS)
         {
-            getJointsModelIdx(pncModelFlexibleOrig_,
+            getJointsModelIdx(*pncModelFlexibleOrig_,
                               flexibleJointsNames_,
                               flexibleJointsModelIdx_);
         }
@@ -664,84 +923,116 @@ namespace jiminy
             returnCode = result_t::ERROR_INIT_FAILED;
         }
 
+        std::shared_ptr<pinocchio::Model const> pncModelOrig;
         if (returnCode == result_t::SUCCESS)
         {
-            // Reset the model either with the original rigid or flexible model
+            // Select either the original rigid or flexible model
             if (mdlOptions_->dynamics.enableFlexibleModel)
             {
-                pncModel_ = pncModelFlexibleOrig_;
+                pncModelOrig = pncModelFlexibleOrig_;
             }
             else
             {
-                pncModel_ = pncModelRigidOrig_;
+                pncModelOrig = std::shared_ptr<pinocchio::Model const>(description_, &description_->pncModelRigid);
             }
+        }
 
-            for (std::string const & jointName : rigidJointsNames_)
+        /* Copy the original model only if it has changed since the last call.
+           Owning it guarantees that its address cannot be reused by another one. */
+        bool_t const isModelStructureInvalid = (pncModelOrig != pncModelBiasedOrig_);
+        if (returnCode == result_t::SUCCESS && isModelStructureInvalid)
+        {
+            pncModel_ = *pncModelOrig;
+            pncData_ = pinocchio::Data(pncModel_);
+            pncModelBiasedOrig_ = pncModelOrig;
+            isModelBiased_ = false;
+
+            /* Initialize the internal proxies.
+               Be careful, the internal proxies of the sensors and motors are
+               not up-to-date at the point, so one cannot use them. */
+            returnCode = refreshProxies();
+
+            // Refresh the motors
+            for (auto & motor : motorsHolder_)
             {
-                int32_t const jointIdx = pncModel_.getJointId(jointName);
+                if (returnCode == result_t::SUCCESS)
+                {
+                    returnCode = motor->refreshProxies();
+                }
+            }
+
+            // Refresh the sensors
+            for (auto & sensorGroup : sensorsGroupHolder_)
+            {
+                for (auto & sensor : sensorGroup.second)
+                {
+                    if (returnCode == result_t::SUCCESS)
+                    {
+                        returnCode = sensor->refreshProxies();
+                    }
+                }
+            }
+        }
+
+        /* Only the dynamic properties of the bodies are updated in-place, so
+           there is nothing to do if the biases are disabled and were already. */
+        dynamicsOptions_t const & dynOptions = mdlOptions_->dynamics;
+        bool_t const isBiasEnabled = dynOptions.centerOfMassPositionBodiesBiasStd > 0.0
+                                  || dynOptions.massBodiesBiasStd > 0.0
+                                  || dynOptions.inertiaBodiesBiasStd > 0.0
+                                  || dynOptions.relativePositionBodiesBiasStd > 0.0;
+        bool_t const isModelBiasInvalid = isBiasEnabled || isModelBiased_;
+        if (returnCode == result_t::SUCCESS && isModelBiasInvalid)
+        {
+            for (int32_t const & jointIdx : rigidJointsModelIdx_)
+            {
+                // Restore the original dynamic properties before adding new biases
+                pncModel_.inertias[jointIdx] = pncModelOrig->inertias[jointIdx];
+                pncModel_.jointPlacements[jointIdx] = pncModelOrig->jointPlacements[jointIdx];
+                if (!isBiasEnabled)
+                {
+                    continue;
+                }
 
                 vector3_t & comRelativePositionBody =
                     const_cast<vector3_t &>(pncModel_.inertias[jointIdx].lever());
-                comRelativePositionBody +=
-                    randVectorNormal(3U, mdlOptions_->dynamics.centerOfMassPositionBodiesBiasStd);
+                for (uint32_t i = 0; i < 3; i++)
+                {
+                    comRelativePositionBody[i] += randNormal(0.0, dynOptions.centerOfMassPositionBodiesBiasStd);
+                }
 
                 // Cannot be less than 1g for numerical stability
                 float64_t & massBody =
                     const_cast<float64_t &>(pncModel_.inertias[jointIdx].mass());
-                massBody =
-                    std::max(massBody +
-                        randNormal(0.0, mdlOptions_->dynamics.massBodiesBiasStd), 1.0e-3);
+                massBody = std::max(massBody + randNormal(0.0, dynOptions.massBodiesBiasStd), 1.0e-3);
 
                 // Cannot be less 1g applied at 1mm of distance from the rotation center
                 vector6_t & inertiaBody =
                     const_cast<vector6_t &>(pncModel_.inertias[jointIdx].inertia().data());
-                inertiaBody =
-                    clamp(inertiaBody +
-                        randVectorNormal(6U, mdlOptions_->dynamics.inertiaBodiesBiasStd), 1.0e-9);
+                for (uint32_t i = 0; i < 6; i++)
+                {
+                    inertiaBody[i] = std::max(inertiaBody[i] + randNormal(0.0, dynOptions.inertiaBodiesBiasStd), 1.0e-9);
+                }
 
                 vector3_t & relativePositionBody =
                     pncModel_.jointPlacements[jointIdx].translation();
-                relativePositionBody +=
-                    randVectorNormal(3U, mdlOptions_->dynamics.relativePositionBodiesBiasStd);
+                for (uint32_t i = 0; i < 3; i++)
+                {
+                    relativePositionBody[i] += randNormal(0.0, dynOptions.relativePositionBodiesBiasStd);
+                }
             }
+            isModelBiased_ = isBiasEnabled;
+        }
 
-            // Initialize Pinocchio Data internal state
-            pncData_ = pinocchio::Data(pncModel_);
+        // Initialize Pinocchio Data internal state
+        if (returnCode == result_t::SUCCESS && (isModelStructureInvalid || isModelBiasInvalid))
+        {
             pinocchio::forwardKinematics(pncModel_, pncData_,
                                          vectorN_t::Zero(pncModel_.nq),
                                          vectorN_t::Zero(pncModel_.nv));
             pinocchio::updateFramePlacements(pncModel_, pncData_);
         }
 
-        /* Initialize the internal proxies.
-           Be careful, the internal proxies of the sensors and motors are
-           not up-to-date at the point, so one cannot use them. */
-        if (returnCode == result_t::SUCCESS)
-        {
-            returnCode = refreshProxies();
-        }
-
-        // Refresh the motors
-        for (auto & motor : motorsHolder_)
-        {
-            if (returnCode == result_t::SUCCESS)
-            {
-                returnCode = motor->refreshProxies();
-            }
-        }
-
-        // Refresh the sensors
-        for (auto & sensorGroup : sensorsGroupHolder_)
-        {
-            for (auto & sensor : sensorGroup.second)
-            {
-                if (returnCode == result_t::SUCCESS)
-                {
-                    returnCode = sensor->refreshProxies();
-                }
-            }
-        }
-
         return returnCode;
     }
 
@@ -1555,40 +1846,14 @@ namespace jiminy
         return hasFreeflyer_;
     }
 
-    result_t Model::loadUrdfModel(std::string const & urdfPath,
-                                  bool_t      const & hasFreeflyer)
+    std::shared_ptr<ModelDescription const> const & Model::getDescription(void) const
     {
-        if (!std::ifstream(urdfPath.c_str()).good())
-        {
-            std::cout << "Error - Model::loadUrdfModel - The URDF file does not exist. Impossible to load it." << std::endl;
-            return result_t::ERROR_BAD_INPUT;
-        }
-
-        urdfPath_ = urdfPath;
-        hasFreeflyer_ = hasFreeflyer;
-
-        try
-        {
-            pinocchio::Model pncModel;
-            if (hasFreeflyer)
-            {
-                pinocchio::urdf::buildModel(urdfPath,
-                                            pinocchio::JointModelFreeFlyer(),
-                                            pncModel);
-            }
-            else
-            {
-                pinocchio::urdf::buildModel(urdfPath, pncModel);
-            }
-            pncModel_ = pncModel;
-        }
-        catch (std::exception& e)
-        {
-            std::cout << "Error - Model::loadUrdfModel - Something is wrong with the URDF. Impossible to build a model from it." << std::endl;
-            return result_t::ERROR_BAD_INPUT;
-        }
+        return description_;
+    }
 
-        return result_t::SUCCESS;
+    pinocchio::Model const & Model::getModelRigidOrig(void) const
+    {
+        return description_->pncModelRigid;
     }
 
     void Model::computeMotorsTorques(float64_t const & t,
@@ -1616,12 +1881,99 @@ namespace jiminy
         return (*motorIt)->get();
     }
 
+    void Model::refreshSensorsKinematicsProxies(void)
+    {
+        sensorsFramesIdx_.clear();
+        for (auto & sensorGroup : sensorsGroupHolder_)
+        {
+            for (auto & sensor : sensorGroup.second)
+            {
+                int32_t const frameIdx = sensor->getKinematicsFrameIdx();
+                if (frameIdx < 0)
+                {
+                    sensor->kinematicsIdx_ = -1;
+                    continue;
+                }
+
+                auto frameIt = std::find(sensorsFramesIdx_.begin(), sensorsFramesIdx_.end(), frameIdx);
+                if (frameIt == sensorsFramesIdx_.end())
+                {
+                    sensorsFramesIdx_.push_back(frameIdx);
+                    frameIt = std::prev(sensorsFramesIdx_.end());
+                }
+                sensor->kinematicsIdx_ = std::distance(sensorsFramesIdx_.begin(), frameIt);
+            }
+        }
+
+        sensorsFramesQuat_.setZero(4, sensorsFramesIdx_.size());
+        sensorsFramesGyro_.setZero(3, sensorsFramesIdx_.size());
+        sensorsFramesAccel_.setZero(3, sensorsFramesIdx_.size());
+    }
+
+    void Model::refreshSensorsDataProxies(void)
+    {
+        // The types are sorted, so that the layout does not depend on the order of attachment
+        std::vector<std::string> sensorsTypes;
+        for (auto const & sensorGroup : sensorsGroupHolder_)
+        {
+            if (!sensorGroup.second.empty())
+            {
+                sensorsTypes.push_back(sensorGroup.first);
+            }
+        }
+        std::sort(sensorsTypes.begin(), sensorsTypes.end());
+
+        sensorsDataSegments_.clear();
+        uint32_t offset = 0;
+        bool_t isLayoutUnchanged = true;
+        for (std::string const & sensorType : sensorsTypes)
+        {
+            SensorSharedDataHolder_t const & sharedHolder = *sensorsSharedHolder_.at(sensorType);
+            uint32_t const size = sharedHolder.dataMeasured_.size();
+            sensorsDataSegments_.emplace(sensorType, std::make_pair(offset, size));
+            isLayoutUnchanged = isLayoutUnchanged && offset + size <= static_cast<uint32_t>(sensorsDataFlat_.size())
+                && sharedHolder.dataMeasured_.data() == sensorsDataFlat_.data() + offset;
+            offset += size;
+        }
+        isLayoutUnchanged = isLayoutUnchanged && offset == static_cast<uint32_t>(sensorsDataFlat_.size());
+
+        /* The measurements of every type of sensors are stored directly in the flat buffer.
+           It is only reallocated if the layout has changed, so that the views on the
+           measurements remain valid otherwise. */
+        if (!isLayoutUnchanged)
+        {
+            vectorN_t sensorsDataFlat = vectorN_t::Zero(offset);
+            for (std::string const & sensorType : sensorsTypes)
+            {
+                sensorsSharedHolder_.at(sensorType)->bindDataMeasured(
+                    sensorsDataFlat.data() + sensorsDataSegments_.at(sensorType).first);
+            }
+            sensorsDataFlat_.swap(sensorsDataFlat);
+        }
+    }
+
+    void Model::computeSensorsKinematics(void)
+    {
+        for (uint32_t i = 0; i < sensorsFramesIdx_.size(); i++)
+        {
+            int32_t const & frameIdx = sensorsFramesIdx_[i];
+            matrix3_t const & rot = pncData_.oMf[frameIdx].rotation();
+            sensorsFramesQuat_.col(i) = quaternion_t(rot).coeffs();
+            sensorsFramesGyro_.col(i) = pinocchio::getFrameVelocity(pncModel_, pncData_, frameIdx).angular();
+            sensorsFramesAccel_.col(i) = pinocchio::getFrameAcceleration(pncModel_, pncData_, frameIdx).linear()
+                                       + rot.transpose() * pncModel_.gravity.linear();
+        }
+    }
+
     void Model::setSensorsData(float64_t const & t,
                                vectorN_t const & q,
                                vectorN_t const & v,
                                vectorN_t const & a,
                                vectorN_t const & u)
     {
+        // Compute the kinematics of the frames of the sensors once for all of them
+        computeSensorsKinematics();
+
         for (auto const & sensorGroup : sensorsGroupHolder_)
         {
             if (!sensorGroup.second.empty())
@@ -1631,6 +1983,51 @@ namespace jiminy
         }
     }
 
+    vectorN_t const & Model::getSensorsDataFlat(void) const
+    {
+        return sensorsDataFlat_;
+    }
+
+    result_t Model::getSensorsDataSegment(std::string const & sensorType,
+                                          uint32_t          & offset,
+                                          uint32_t          & size) const
+    {
+        auto segmentIt = sensorsDataSegments_.find(sensorType);
+        if (segmentIt == sensorsDataSegments_.end())
+        {
+            std::cout << "Error - Model::getSensorsDataSegment - No sensor of this type exists." << std::endl;
+            return result_t::ERROR_BAD_INPUT;
+        }
+
+        offset = segmentIt->second.first;
+        size = segmentIt->second.second;
+
+        return result_t::SUCCESS;
+    }
+
+    result_t Model::getSensorDataOffset(std::string const & sensorType,
+                                        std::string const & sensorName,
+                                        uint32_t          & offset) const
+    {
+        result_t returnCode = result_t::SUCCESS;
+
+        std::shared_ptr<AbstractSensorBase const> sensor;
+        returnCode = getSensor(sensorType, sensorName, sensor);
+
+        uint32_t size = 0;
+        if (returnCode == result_t::SUCCESS)
+        {
+            returnCode = getSensorsDataSegment(sensorType, offset, size);
+        }
+
+        if (returnCode == result_t::SUCCESS)
+        {
+            offset += sensor->getIdx() * sensor->getSize();
+        }
+
+        return returnCode;
+    }
+
     sensorsDataMap_t Model::getSensorsData(void) const
     {
         sensorsDataMap_t data;
@@ -1667,7 +2064,7 @@ namespace jiminy
                                      {
                                          return (elem->getName() == sensorName);
                                      });
-        return *(*sensorIt)->get();
+        return (*sensorIt)->get();
     }
 
     void Model::updateTelemetry(void)
@@ -0,0 +1,605 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief TelemetryDataset Implementation.
+///
+//////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+
+#ifndef _WIN32
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "jiminy/core/TelemetryData.h"
+#include "jiminy/core/TelemetryRecorder.h"
+#include "jiminy/core/TelemetryDataset.h"
+
+
+namespace jiminy
+{
+    TelemetryDataset::TelemetryDataset(void) :
+    filename_(),
+    modes_(OpenMode::NOT_OPEN),
+    file_(),
+    mapping_(),
+    mappedAddress_(nullptr),
+    mappedSize_(0),
+    preamble_(),
+    headerRaw_(),
+    header_(),
+    episodes_()
+    {
+        // Empty.
+    }
+
+    TelemetryDataset::~TelemetryDataset(void)
+    {
+        close();
+    }
+
+    result_t TelemetryDataset::open(std::string   const & filename,
+                                    enum OpenMode const & mode)
+    {
+        result_t returnCode = result_t::SUCCESS;
+
+        if (isOpen())
+        {
+            std::cout << "Error - TelemetryDataset::open - Dataset already open." << std::endl;
+            returnCode = result_t::ERROR_GENERIC;
+        }
+
+        if (returnCode == result_t::SUCCESS)
+        {
+            std::memset(&preamble_, 0, sizeof(datasetPreamble_t));
+            headerRaw_.clear();
+            header_.clear();
+            episodes_.clear();
+
+            if (mode & OpenMode::READ_ONLY)
+            {
+                returnCode = openRead(filename);
+            }
+            else if ((mode & OpenMode::WRITE_ONLY) || (mode & OpenMode::READ_WRITE))
+            {
+                returnCode = openWrite(filename, mode);
+            }
+            else
+            {
+                std::cout << "Error - TelemetryDataset::open - Unsupported opening mode." << std::endl;
+                returnCode = result_t::ERROR_BAD_INPUT;
+            }
+        }
+
+        if (returnCode == result_t::SUCCESS)
+        {
+            filename_ = filename;
+            modes_ = mode;
+        }
+        else
+        {
+            close();
+        }
+
+        return returnCode;
+    }
+
+    result_t TelemetryDataset::openRead(std::string const & filename)
+    {
+        result_t returnCode = result_t::SUCCESS;
+
+        // Map the whole file in memory
+        #ifndef _WIN32
+        int32_t const fileDescriptor = ::open(filename.c_str(), O_RDONLY);
+        if (fileDescriptor < 0)
+        {
+            std::cout << "Error - TelemetryDataset::open - Impossible to open the dataset file. Check that the file exists and that you have reading permissions." << std::endl;
+            returnCode = result_t::ERROR_BAD_INPUT;
+        }
+
+        if (returnCode == result_t::SUCCESS)
+        {
+            struct stat st;
+            if (::fstat(fileDescriptor, &st) < 0 || st.st_size == 0)
+            {
+                std::cout << "Error - TelemetryDataset::open - Impossible to access the dataset file, or the file is empty." << std::endl;
+                returnCode = result_t::ERROR_BAD_INPUT;
+            }
+            else
+            {
+                mappedSize_ = st.st_size;
+                void * address = ::mmap(nullptr, mappedSize_, PROT_READ, MAP_SHARED, fileDescriptor, 0);
+                if (address == MAP_FAILED)
+                {
+                    std::cout << "Error - TelemetryDataset::open - Impossible to map the dataset file in memory." << std::endl;
+                    mappedSize_ = 0;
+                    returnCode = result_t::ERROR_GENERIC;
+                }
+                else
+                {
+                    // The file is unmapped once the last owner of the mapping is destroyed
+                    int64_t const mappedSize = mappedSize_;
+                    mapping_ = std::shared_ptr<char_t const>(
+                        static_cast<char_t const *>(address),
+                        [mappedSize](char_t const * mappedAddress)
+                        {
+                            ::munmap(const_cast<char_t *>(mappedAddress), mappedSize);
+                        });
+                    mappedAddress_ = mapping_.get();
+                }
+            }
+        }
+
+        if (fileDescriptor >= 0)
+        {
+            // The mapping remains valid after closing the file descriptor
+            ::close(fileDescriptor);
+        }
+        #else
+        std::ifstream myFile = std::ifstream(filename,
+                                             std::ios::in |
+                                             std::ifstream::binary |
+                                             std::ifstream::ate);
+        if (myFile.is_open())
+        {
+            mappedSize_ = myFile.tellg();
+            mapping_ = std::shared_ptr<char_t const>(new char_t[mappedSize_], std::default_delete<char_t[]>());
+            mappedAddress_ = mapping_.get();
+            myFile.seekg(0);
+            myFile.read(const_cast<char_t *>(mappedAddress_), mappedSize_);
+            myFile.close();
+        }
+        else
+        {
+            std::cout << "Error - TelemetryDataset::open - Impossible to open the dataset file. Check that the file exists and that you have reading permissions." << std::endl;
+            returnCode = result_t::ERROR_BAD_INPUT;
+        }
+        #endif
+
+        // Parse the preamble, the header and the table of episodes
+        if (returnCode == result_t::SUCCESS)
+        {
+            if (mappedSize_ < static_cast<int64_t>(sizeof(datasetPreamble_t)))
+            {
+                std::cout << "Error - TelemetryDataset::open - Corrupted dataset file." << std::endl;
+                returnCode = result_t::ERROR_BAD_INPUT;
+            }
+        }
+
+        if (returnCode == result_t::SUCCESS)
+        {
+            std::memcpy(&preamble_, mappedAddress_, sizeof(datasetPreamble_t));
+            returnCode = checkPreamble(mappedSize_);
+        }
+
+        if (returnCode == result_t::SUCCESS)
+        {
+            char_t const * headerAddress = mappedAddress_ + sizeof(datasetPreamble_t);
+            headerRaw_.assign(headerAddress, headerAddress + preamble_.headerSize);
+            returnCode = parseHeader(headerRaw_.data());
+        }
+
+        if (returnCode == result_t::SUCCESS)
+        {
+            datasetEpisode_t const * episodesAddress =
+                reinterpret_cast<datasetEpisode_t const *>(mappedAddress_ + preamble_.indexOffset);
+            episodes_.assign(episodesAddress, episodesAddress + preamble_.numEpisodes);
+
+            // Make sure every episode lies in the data section
+            for (datasetEpisode_t const & episode : episodes_)
+            {
+                if (episode.offset < preamble_.dataOffset
+                 || episode.offset > preamble_.indexOffset
+                 || episode.numRows < 0
+                 || episode.numRows > (preamble_.indexOffset - episode.offset) / preamble_.rowSize)
+                {
+                    std::cout << "Error - TelemetryDataset::open - Corrupted table of episodes." << std::endl;
+                    returnCode = result_t::ERROR_BAD_INPUT;
+                    break;
+                }
+            }
+        }
+
+        return returnCode;
+    }
+
+    result_t TelemetryDataset::checkPreamble(int64_t const & fileSize) const
+    {
+        if (std::strncmp(preamble_.magic, DATASET_MAGIC.c_str(), sizeof(preamble_.magic)) != 0
+         || preamble_.version != TELEMETRY_DATASET_VERSION)
+        {
+            std::cout << "Error - TelemetryDataset::open - Corrupted dataset file, or unsupported version." << std::endl;
+            return result_t::ERROR_BAD_INPUT;
+        }
+
+        /* Check the consistency of every section with the size of the file, without
+           overflowing, before reading anything else from it. */
+        int64_t const headerEnd = sizeof(datasetPreamble_t) + preamble_.headerSize;
+        if (preamble_.numIntEntries < 1
+         || preamble_.numFloatEntries < 0
+         || preamble_.rowSize != (preamble_.numIntEntries + preamble_.numFloatEntries) * static_cast<int32_t>(sizeof(int32_t))
+         || preamble_.headerSize < static_cast<int64_t>(sizeof(int32_t))
+         || preamble_.headerSize > fileSize
+         || preamble_.dataOffset < headerEnd
+         || preamble_.indexOffset < preamble_.dataOffset
+         || preamble_.indexOffset > fileSize
+         || preamble_.numEpisodes < 0
+         || preamble_.numEpisodes > (fileSize - preamble_.indexOffset) / static_cast<int64_t>(sizeof(datasetEpisode_t)))
+        {
+            std::cout << "Error - TelemetryDataset::open - Corrupted or truncated dataset file." << std::endl;
+            return result_t::ERROR_BAD_INPUT;
+        }
+
+        return result_t::SUCCESS;
+    }
+
+    result_t TelemetryDataset::openWrite(std::string   const & filename,
+                                         enum OpenMode const & mode)
+    {
+        result_t returnCode = result_t::SUCCESS;
+
+        // Create the file if it does not exist, or if the existing episodes must be discarded
+        bool_t const isNewFile = (mode & OpenMode::TRUNCATE) || !std::ifstream(filename).good();
+        if (isNewFile)
+        {
+            file_.open(filename, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+        }
+        else
+        {
+            file_.open(filename, std::ios::in | std::ios::out | std::ios::binary);
+        }
+
+        if (!file_.is_open())
+        {
+            std::cout << "Error - TelemetryDataset::open - Impossible to open the dataset file. Check if root folder exists and if you have writing permissions." << std::endl;
+            returnCode = result_t::ERROR_BAD_INPUT;
+        }
+
+        /* Load the preamble, header and table of episodes of an existing dataset.
+           Nothing is written until the first episode is appended. */
+        if (returnCode == result_t::SUCCESS && !isNewFile)
+        {
+            file_.seekg(0, std::ios::end);
+            int64_t const fileSize = file_.tellg();
+            file_.seekg(0);
+
+            if (fileSize > 0)
+            {
+                file_.read(reinterpret_cast<char_t *>(&preamble_), sizeof(datasetPreamble_t));
+                if (!file_.good())
+                {
+                    std::cout << "Error - TelemetryDataset::open - Corrupted dataset file." << std::endl;
+                    returnCode = result_t::ERROR_BAD_INPUT;
+                }
+
+                if (returnCode == result_t::SUCCESS)
+                {
+                    returnCode = checkPreamble(fileSize);
+                }
+
+                if (returnCode == result_t::SUCCESS)
+                {
+                    headerRaw_.resize(preamble_.headerSize);
+                    file_.read(headerRaw_.data(), preamble_.headerSize);
+                    episodes_.resize(preamble_.numEpisodes);
+                    file_.seekg(preamble_.indexOffset);
+                    file_.read(reinterpret_cast<char_t *>(episodes_.data()),
+                               preamble_.numEpisodes * sizeof(datasetEpisode_t));
+                    if (!file_.good())
+                    {
+                        std::cout << "Error - TelemetryDataset::open - Corrupted dataset file." << std::endl;
+                        returnCode = result_t::ERROR_BAD_INPUT;
+                    }
+                }
+
+                if (returnCode == result_t::SUCCESS)
+                {
+                    returnCode = parseHeader(headerRaw_.data());
+                }
+            }
+        }
+
+        return returnCode;
+    }
+
+    result_t TelemetryDataset::parseHeader(char_t const * headerRaw)
+    {
+        header_.clear();
+
+        // Skip the version flag, then split the null-terminated fields
+        char_t const * pHeader = headerRaw + sizeof(int32_t);
+        char_t const * pHeaderEnd = headerRaw + preamble_.headerSize;
+        while (pHeader < pHeaderEnd)
+        {
+            char_t const * pFieldEnd = std::find(pHeader, pHeaderEnd, '\0');
+            header_.emplace_back(pHeader, pFieldEnd);
+            pHeader = pFieldEnd + 1;
+        }
+
+        if (std::find(header_.begin(), header_.end(), START_COLUMNS) == header_.end())
+        {
+            std::cout << "Error - TelemetryDataset::parseHeader - Corrupted telemetry header." << std::endl;
+            return result_t::ERROR_BAD_INPUT;
+        }
+
+        return result_t::SUCCESS;
+    }
+
+    result_t TelemetryDataset::flush(void)
+    {
+        if (!isWritable())
+        {
+            std::cout << "Error - TelemetryDataset::flush - Dataset not open in writing mode." << std::endl;
+            return result_t::ERROR_GENERIC;
+        }
+
+        // Nothing to do if no episode has been appended yet
+        if (headerRaw_.empty())
+        {
+            return result_t::SUCCESS;
+        }
+
+        // Write the table of episodes right after the data section
+        file_.seekp(preamble_.indexOffset);
+        file_.write(reinterpret_cast<char_t const *>(episodes_.data()),
+                    episodes_.size() * sizeof(datasetEpisode_t));
+
+        // Update the preamble
+        file_.seekp(0);
+        file_.write(reinterpret_cast<char_t const *>(&preamble_), sizeof(datasetPreamble_t));
+
+        file_.flush();
+        if (!file_.good())
+        {
+            std::cout << "Error - TelemetryDataset::flush - Impossible to write the dataset file." << std::endl;
+            return result_t::ERROR_GENERIC;
+        }
+
+        return result_t::SUCCESS;
+    }
+
+    void TelemetryDataset::close(void)
+    {
+        if (file_.is_open())
+        {
+            flush();
+            file_.close();
+        }
+
+        // The file is only unmapped if the mapping is not shared
+        mapping_.reset();
+        mappedAddress_ = nullptr;
+        mappedSize_ = 0;
+
+        modes_ = OpenMode::NOT_OPEN;
+    }
+
+    bool_t TelemetryDataset::isOpen(void) const
+    {
+        return (modes_ != OpenMode::NOT_OPEN);
+    }
+
+    bool_t TelemetryDataset::isWritable(void) const
+    {
+        return file_.is_open();
+    }
+
+    result_t TelemetryDataset::appendEpisode(TelemetryRecorder & recorder)
+    {
+        result_t returnCode = result_t::SUCCESS;
+
+        if (!isWritable())
+        {
+            std::cout << "Error - TelemetryDataset::appendEpisode - Dataset not open in writing mode." << std::endl;
+            returnCode = result_t::ERROR_GENERIC;
+        }
+
+        std::vector<char_t> headerRaw;
+        if (returnCode == result_t::SUCCESS)
+        {
+            recorder.getHeaderRaw(headerRaw);
+            if (headerRaw.empty())
+            {
+                std::cout << "Error - TelemetryDataset::appendEpisode - Nothing has been recorded." << std::endl;
+                returnCode = result_t::ERROR_INIT_FAILED;
+            }
+        }
+
+        std::vector<char_t> rows;
+        int32_t numIntEntries;
+        int32_t numFloatEntries;
+        int64_t numRows = 0;
+        if (returnCode == result_t::SUCCESS)
+        {
+            numRows = recorder.getDataRows(rows, numIntEntries, numFloatEntries);
+        }
+
+        if (returnCode == result_t::SUCCESS)
+        {
+            if (headerRaw_.empty())
+            {
+                // First episode: write the preamble and the telemetry header once and for all
+                std::memcpy(preamble_.magic, DATASET_MAGIC.c_str(), DATASET_MAGIC.size() + 1);
+                preamble_.version = TELEMETRY_DATASET_VERSION;
+                preamble_.numIntEntries = numIntEntries;
+                preamble_.numFloatEntries = numFloatEntries;
+                preamble_.rowSize = (numIntEntries + numFloatEntries) * sizeof(int32_t);
+                preamble_.headerSize = headerRaw.size();
+                int64_t const headerEnd = sizeof(datasetPreamble_t) + preamble_.headerSize;
+                preamble_.dataOffset = ((headerEnd + 7) / 8) * 8; // Align the data section on 8 bytes
+                preamble_.indexOffset = preamble_.dataOffset;
+                preamble_.numEpisodes = 0;
+
+                headerRaw_ = std::move(headerRaw);
+                returnCode = parseHeader(headerRaw_.data());
+
+                if (returnCode == result_t::SUCCESS)
+                {
+                    std::vector<char_t> padding(preamble_.dataOffset - headerEnd, '\0');
+                    file_.seekp(0);
+                    file_.write(reinterpret_cast<char_t const *>(&preamble_), sizeof(datasetPreamble_t));
+                    file_.write(headerRaw_.data(), headerRaw_.size());
+                    file_.write(padding.data(), padding.size());
+                }
+            }
+            else if (headerRaw != headerRaw_)
+            {
+                std::cout << "Error - TelemetryDataset::appendEpisode - The telemetry header of the episode does not match the one of the dataset." << std::endl;
+                returnCode = result_t::ERROR_BAD_INPUT;
+            }
+        }
+
+        if (returnCode == result_t::SUCCESS)
+        {
+            // Append the rows in place of the previous table of episodes
+            file_.seekp(preamble_.indexOffset);
+            file_.write(rows.data(), rows.size());
+            if (!file_.good())
+            {
+                std::cout << "Error - TelemetryDataset::appendEpisode - Impossible to write the dataset file." << std::endl;
+                returnCode = result_t::ERROR_GENERIC;
+            }
+        }
+
+        if (returnCode == result_t::SUCCESS)
+        {
+            episodes_.push_back({preamble_.indexOffset, numRows});
+            preamble_.indexOffset += numRows * preamble_.rowSize;
+            ++preamble_.numEpisodes;
+        }
+
+        return returnCode;
+    }
+
+    std::vector<std::string> const & TelemetryDataset::getHeader(void) const
+    {
+        return header_;
+    }
+
+    int32_t TelemetryDataset::getColumnIdx(std::string const & fieldName) const
+    {
+        auto start = std::find(header_.begin(), header_.end(), START_COLUMNS);
+        auto iterator = std::find(start, header_.end(), fieldName);
+        if (start == header_.end() || iterator == header_.end())
+        {
+            return -1;
+        }
+        return std::distance(start, iterator) - 1;
+    }
+
+    int64_t TelemetryDataset::getNumEpisodes(void) const
+    {
+        return preamble_.numEpisodes;
+    }
+
+    int32_t TelemetryDataset::getNumIntEntries(void) const
+    {
+        return preamble_.numIntEntries;
+    }
+
+    int32_t TelemetryDataset::getNumFloatEntries(void) const
+    {
+        return preamble_.numFloatEntries;
+    }
+
+    int64_t TelemetryDataset::getEpisodeLength(int64_t const & episodeIdx) const
+    {
+        if (episodeIdx < 0 || episodeIdx >= static_cast<int64_t>(episodes_.size()))
+        {
+            return 0;
+        }
+        return episodes_[episodeIdx].numRows;
+    }
+
+    char_t const * TelemetryDataset::getEpisodeRaw(int64_t const & episodeIdx,
+                                                   int64_t       & numRows,
+                                                   int32_t       & rowSize) const
+    {
+        numRows = 0;
+        rowSize = preamble_.rowSize;
+
+        if (mappedAddress_ == nullptr)
+        {
+            std::cout << "Error - TelemetryDataset::getEpisodeRaw - Dataset not open in reading mode." << std::endl;
+            return nullptr;
+        }
+
+        if (episodeIdx < 0 || episodeIdx >= static_cast<int64_t>(episodes_.size()))
+        {
+            std::cout << "Error - TelemetryDataset::getEpisodeRaw - Episode index out of range." << std::endl;
+            return nullptr;
+        }
+
+        numRows = episodes_[episodeIdx].numRows;
+        return mappedAddress_ + episodes_[episodeIdx].offset;
+    }
+
+    datasetColumn_t<int32_t> TelemetryDataset::getIntColumn(int64_t const & episodeIdx,
+                                                            int32_t const & columnIdx) const
+    {
+        int64_t numRows;
+        int32_t rowSize;
+        char_t const * rowsAddress = getEpisodeRaw(episodeIdx, numRows, rowSize);
+        if (rowsAddress == nullptr || columnIdx < 0 || columnIdx >= preamble_.numIntEntries)
+        {
+            return datasetColumn_t<int32_t>(nullptr, 0, Eigen::InnerStride<>(1));
+        }
+
+        return datasetColumn_t<int32_t>(reinterpret_cast<int32_t const *>(rowsAddress) + columnIdx,
+                                        numRows, Eigen::InnerStride<>(rowSize / sizeof(int32_t)));
+    }
+
+    datasetColumn_t<float32_t> TelemetryDataset::getFloatColumn(int64_t const & episodeIdx,
+                                                                int32_t const & columnIdx) const
+    {
+        int64_t numRows;
+        int32_t rowSize;
+        char_t const * rowsAddress = getEpisodeRaw(episodeIdx, numRows, rowSize);
+        if (rowsAddress == nullptr || columnIdx < preamble_.numIntEntries
+        || columnIdx >= preamble_.numIntEntries + preamble_.numFloatEntries)
+        {
+            return datasetColumn_t<float32_t>(nullptr, 0, Eigen::InnerStride<>(1));
+        }
+
+        return datasetColumn_t<float32_t>(reinterpret_cast<float32_t const *>(rowsAddress) + columnIdx,
+                                          numRows, Eigen::InnerStride<>(rowSize / sizeof(float32_t)));
+    }
+
+    std::shared_ptr<char_t const> const & TelemetryDataset::getMapping(void) const
+    {
+        return mapping_;
+    }
+
+    result_t TelemetryDataset::getEpisodeData(int64_t   const & episodeIdx,
+                                              matrixN_t       & logData) const
+    {
+        int64_t numRows;
+        int32_t rowSize;
+        char_t const * rowsAddress = getEpisodeRaw(episodeIdx, numRows, rowSize);
+        if (rowsAddress == nullptr)
+        {
+            return result_t::ERROR_BAD_INPUT;
+        }
+
+        // Same layout as Engine::getLogData, with the time in seconds
+        int32_t const numIntEntries = preamble_.numIntEntries;
+        int32_t const numFloatEntries = preamble_.numFloatEntries;
+        logData.resize(numRows, numIntEntries + numFloatEntries);
+        logData.col(0) = getIntColumn(episodeIdx, 0).cast<float64_t>() * 1.0e-6;
+        for (int32_t i = 1; i < numIntEntries; i++)
+        {
+            logData.col(i) = getIntColumn(episodeIdx, i).cast<float64_t>();
+        }
+        for (int32_t i = numIntEntries; i < numIntEntries + numFloatEntries; i++)
+        {
+            logData.col(i) = getFloatColumn(episodeIdx, i).cast<float64_t>();
+        }
+
+        return result_t::SUCCESS;
+    }
+}
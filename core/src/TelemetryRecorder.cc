@@ -6,6 +6,8 @@
 
 #include <iomanip>
 #include <fstream>
+#include <cstring>
+#include <thread>
 
 #include "jiminy/core/TelemetryRecorder.h"
 
@@ -188,6 +190,36 @@ namespace jiminy
         return result_t::SUCCESS;
     }
 
+    void TelemetryRecorder::readHeader(AbstractIODevice         * flow,
+                                       int64_t            const & headerSize,
+                                       std::vector<std::string> & header)
+    {
+        int64_t header_version_length = sizeof(int32_t);
+        flow->seek(header_version_length); // Skip the version flag
+        std::vector<char_t> headerCharBuffer;
+        headerCharBuffer.resize(headerSize - header_version_length);
+        flow->readData(headerCharBuffer.data(), headerSize - header_version_length);
+        char_t const * pHeader = &headerCharBuffer[0];
+        uint32_t posHeader = 0;
+        std::string fieldHeader(pHeader);
+        while (true)
+        {
+            header.emplace_back(std::move(fieldHeader));
+            posHeader += header.back().size() + 1;
+            fieldHeader = std::string(pHeader + posHeader);
+            if (fieldHeader.size() == 0 || posHeader >= headerCharBuffer.size())
+            {
+                break;
+            }
+            if (posHeader + fieldHeader.size() > headerCharBuffer.size())
+            {
+                fieldHeader = std::string(pHeader + posHeader, headerCharBuffer.size() - posHeader);
+                header.emplace_back(std::move(fieldHeader));
+                break;
+            }
+        }
+    }
+
     void TelemetryRecorder::getData(std::vector<std::string>                   & header,
                                     std::vector<float64_t>                     & timestamps,
                                     std::vector<std::vector<int32_t> >         & intData,
@@ -220,30 +252,7 @@ namespace jiminy
                 It makes the reasonable assumption that it does not overlap on several chunks. */
                 if (i == 0)
                 {
-                    int64_t header_version_length = sizeof(int32_t);
-                    flows[i]->seek(header_version_length); // Skip the version flag
-                    std::vector<char_t> headerCharBuffer;
-                    headerCharBuffer.resize(headerSize - header_version_length);
-                    flows[i]->readData(headerCharBuffer.data(), headerSize - header_version_length);
-                    char_t const * pHeader = &headerCharBuffer[0];
-                    uint32_t posHeader = 0;
-                    std::string fieldHeader(pHeader);
-                    while (true)
-                    {
-                        header.emplace_back(std::move(fieldHeader));
-                        posHeader += header.back().size() + 1;
-                        fieldHeader = std::string(pHeader + posHeader);
-                        if (fieldHeader.size() == 0 || posHeader >= headerCharBuffer.size())
-                        {
-                            break;
-                        }
-                        if (posHeader + fieldHeader.size() > headerCharBuffer.size())
-                        {
-                            fieldHeader = std::string(pHeader + posHeader, headerCharBuffer.size() - posHeader);
-                            header.emplace_back(std::move(fieldHeader));
-                            break;
-                        }
-                    }
+                    readHeader(flows[i], headerSize, header);
                 }
 
                 /* Dealing with data lines, starting with new line flag, time, integers, and ultimately floats. */
@@ -302,4 +311,237 @@ namespace jiminy
                 headerSize_,
                 recordedBytesDataLine_);
     }
-}
\ No newline at end of file
+
+    result_t TelemetryRecorder::getDataColumns(std::vector<std::string>         & header,
+                                               vectorN_t                        & timestamps,
+                                               intDataMatrix_t                  & intData,
+                                               floatDataMatrix_t                & floatData,
+                                               std::vector<AbstractIODevice *>  & flows,
+                                               int64_t                    const & integerSectionSize,
+                                               int64_t                    const & floatSectionSize,
+                                               int64_t                    const & headerSize,
+                                               uint32_t                   const & numThreads)
+    {
+        result_t returnCode = result_t::SUCCESS;
+
+        int64_t const lineTokenSize = START_LINE_TOKEN.size();
+        int64_t const numInts = integerSectionSize / sizeof(int32_t);
+        int64_t const numFloats = floatSectionSize / sizeof(float32_t);
+        int64_t const intLineSize = sizeof(int32_t) + integerSectionSize; // Including the timestamp
+        int64_t const lineSize = lineTokenSize + intLineSize + floatSectionSize;
+
+        header.clear();
+
+        // Load every chunk at once, and find the number of valid lines based on the line tokens
+        std::vector<std::vector<char_t> > chunks(flows.size());
+        std::vector<int64_t> chunksNumLines(flows.size(), 0);
+        int64_t numLines = 0;
+        for (uint32_t i=0; i<flows.size(); i++)
+        {
+            int64_t pos_old = flows[i]->pos();
+            flows[i]->seek(0);
+
+            int64_t chunkDataStart = 0;
+            if (i == 0)
+            {
+                readHeader(flows[i], headerSize, header);
+                chunkDataStart = headerSize;
+            }
+
+            int64_t const chunkSize = flows[i]->size() - chunkDataStart;
+            if (chunkSize > 0)
+            {
+                flows[i]->seek(chunkDataStart);
+                chunks[i].resize(chunkSize);
+                returnCode = flows[i]->read(chunks[i].data(), chunkSize);
+                if (returnCode != result_t::SUCCESS)
+                {
+                    std::cout << "Error - TelemetryRecorder::getDataColumns - Impossible to read the data." << std::endl;
+                    break;
+                }
+            }
+
+            if (i == flows.size() - 1 && pos_old < flows[i]->size())
+            {
+                flows[i]->seek(pos_old);
+            }
+
+            // The unused part of the memory chunks is filled with zeros, and therefore has no line token
+            int64_t const maxLines = chunkSize / lineSize;
+            char_t const * chunkAddress = chunks[i].data();
+            int64_t chunkNumLines = 0;
+            while (chunkNumLines < maxLines
+            && std::memcmp(chunkAddress + chunkNumLines * lineSize, START_LINE_TOKEN.data(), lineTokenSize) == 0)
+            {
+                ++chunkNumLines;
+            }
+            chunksNumLines[i] = chunkNumLines;
+            numLines += chunkNumLines;
+        }
+
+        if (returnCode == result_t::SUCCESS)
+        {
+            timestamps.resize(numLines);
+            intData.resize(numLines, numInts);
+            floatData.resize(numLines, numFloats);
+
+            /* Transpose the lines by blocks. Each block is first copied in row-major
+               buffers, stripped of the line tokens to get properly aligned data, then
+               written column by column in the output matrices. */
+            int64_t const blockNumLines = std::max(TRANSPOSE_BLOCK_SIZE / lineSize, int64_t(8));
+            struct transposeBlock_t
+            {
+                char_t const * address;
+                int64_t lineIdx;
+                int64_t size;
+            };
+            std::vector<transposeBlock_t> blocks;
+            int64_t lineIdx = 0;
+            for (uint32_t i=0; i<flows.size(); i++)
+            {
+                for (int64_t blockStart = 0; blockStart < chunksNumLines[i]; blockStart += blockNumLines)
+                {
+                    int64_t const blockSize = std::min(blockNumLines, chunksNumLines[i] - blockStart);
+                    blocks.push_back({chunks[i].data() + blockStart * lineSize + lineTokenSize, lineIdx, blockSize});
+                    lineIdx += blockSize;
+                }
+            }
+
+            // The blocks cover disjoint rows, so that they can be transposed concurrently
+            auto transposeBlocks =
+                [&](std::size_t const & blockIdxStart,
+                    std::size_t const & blockIdxEnd)
+                {
+                    Eigen::Matrix<int32_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> intBlock(blockNumLines, numInts + 1);
+                    Eigen::Matrix<float32_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> floatBlock(blockNumLines, numFloats);
+                    for (std::size_t k = blockIdxStart; k < blockIdxEnd; k++)
+                    {
+                        transposeBlock_t const & block = blocks[k];
+                        char_t const * lineAddress = block.address;
+                        for (int64_t j=0; j<block.size; j++)
+                        {
+                            std::memcpy(intBlock.row(j).data(), lineAddress, intLineSize);
+                            std::memcpy(floatBlock.row(j).data(), lineAddress + intLineSize, floatSectionSize);
+                            lineAddress += lineSize;
+                        }
+
+                        timestamps.segment(block.lineIdx, block.size) = intBlock.col(0).head(block.size).cast<float64_t>() * 1.0e-6;
+                        intData.middleRows(block.lineIdx, block.size) = intBlock.block(0, 1, block.size, numInts);
+                        floatData.middleRows(block.lineIdx, block.size) = floatBlock.topRows(block.size);
+                    }
+                };
+
+            // The calling thread is processing the last share of the blocks
+            std::size_t numWorkers = numThreads;
+            if (numWorkers == 0U)
+            {
+                numWorkers = std::max(std::thread::hardware_concurrency(), 1U);
+            }
+            numWorkers = std::max(std::min(numWorkers, blocks.size()), std::size_t(1));
+            std::vector<std::thread> workers;
+            for (std::size_t i = 0; i < numWorkers - 1; i++)
+            {
+                workers.emplace_back(transposeBlocks,
+                                     (i * blocks.size()) / numWorkers,
+                                     ((i + 1) * blocks.size()) / numWorkers);
+            }
+            transposeBlocks(((numWorkers - 1) * blocks.size()) / numWorkers, blocks.size());
+            for (std::thread & worker : workers)
+            {
+                worker.join();
+            }
+        }
+
+        return returnCode;
+    }
+
+    result_t TelemetryRecorder::getDataColumns(std::vector<std::string> & header,
+                                               vectorN_t                & timestamps,
+                                               intDataMatrix_t          & intData,
+                                               floatDataMatrix_t        & floatData,
+                                               uint32_t           const & numThreads)
+    {
+        std::vector<AbstractIODevice *> abstractFlows_;
+        for(MemoryDevice & device: flows_)
+        {
+            abstractFlows_.push_back(&device);
+        }
+
+        return getDataColumns(header,
+                              timestamps,
+                              intData,
+                              floatData,
+                              abstractFlows_,
+                              integerSectionSize_,
+                              floatSectionSize_,
+                              headerSize_,
+                              numThreads);
+    }
+
+    void TelemetryRecorder::getHeaderRaw(std::vector<char_t> & header)
+    {
+        if (isInitialized_)
+        {
+            telemetryData_->formatHeader(header);
+        }
+        else
+        {
+            header.clear();
+        }
+    }
+
+    int64_t TelemetryRecorder::getDataRows(std::vector<char_t> & rows,
+                                           int32_t             & numIntEntries,
+                                           int32_t             & numFloatEntries)
+    {
+        int64_t const lineTokenSize = START_LINE_TOKEN.size();
+        int64_t const rowSize = recordedBytesDataLine_ - lineTokenSize;
+        numIntEntries = static_cast<int32_t>(integerSectionSize_ / sizeof(int32_t)) + 1; // +1 because of Global.Time
+        numFloatEntries = static_cast<int32_t>(floatSectionSize_ / sizeof(float32_t));
+
+        rows.clear();
+
+        if (flows_.empty() || recordedBytesDataLine_ <= 0)
+        {
+            return 0;
+        }
+
+        // Only the part of the chunks that has actually been written is relevant
+        int64_t numRows = 0;
+        std::vector<int64_t> chunksNumRows;
+        for (uint32_t i=0; i<flows_.size(); i++)
+        {
+            int64_t const chunkDataSize = flows_[i].pos() - (i == 0 ? headerSize_ : 0);
+            chunksNumRows.push_back(std::max(chunkDataSize, int64_t(0)) / recordedBytesDataLine_);
+            numRows += chunksNumRows.back();
+        }
+        rows.resize(numRows * rowSize);
+
+        // Copy the rows chunk by chunk, skipping the line tokens
+        std::vector<char_t> bufferChunk;
+        char_t * rowPtr = rows.data();
+        for (uint32_t i=0; i<flows_.size(); i++)
+        {
+            if (chunksNumRows[i] == 0)
+            {
+                continue;
+            }
+
+            /* Reading every recorded line moves the cursor back to its original
+               position, which is required to keep on recording afterward. */
+            int64_t const chunkDataStart = (i == 0 ? headerSize_ : 0);
+            int64_t const chunkDataSize = chunksNumRows[i] * recordedBytesDataLine_;
+            bufferChunk.resize(chunkDataSize);
+            flows_[i].seek(chunkDataStart);
+            flows_[i].readData(bufferChunk.data(), chunkDataSize);
+
+            for (int64_t j=0; j<chunksNumRows[i]; j++)
+            {
+                std::memcpy(rowPtr, bufferChunk.data() + j * recordedBytesDataLine_ + lineTokenSize, rowSize);
+                rowPtr += rowSize;
+            }
+        }
+
+        return numRows;
+    }
+}
@@ -0,0 +1,159 @@
+#include <cmath>
+
+#include "pinocchio/algorithm/kinematics.hpp"
+
+#include "jiminy/core/Model.h"
+#include "jiminy/core/TerminationConditions.h"
+
+
+namespace jiminy
+{
+    result_t AbstractTerminationCondition::initialize(Model const & model)
+    {
+        return result_t::SUCCESS;
+    }
+
+    StateBoundsCondition::StateBoundsCondition(uint32_t  const & startIdx,
+                                               vectorN_t const & lowerBound,
+                                               vectorN_t const & upperBound) :
+    AbstractTerminationCondition(),
+    startIdx_(startIdx),
+    lowerBound_(lowerBound),
+    upperBound_(upperBound)
+    {
+        // Empty.
+    }
+
+    result_t StateBoundsCondition::initialize(Model const & model)
+    {
+        if (lowerBound_.size() != upperBound_.size()
+         || startIdx_ + static_cast<uint32_t>(lowerBound_.size()) > model.nx())
+        {
+            std::cout << "Error - StateBoundsCondition::initialize - The bounds are inconsistent with the dimension of the state." << std::endl;
+            return result_t::ERROR_BAD_INPUT;
+        }
+
+        return result_t::SUCCESS;
+    }
+
+    std::shared_ptr<AbstractTerminationCondition> StateBoundsCondition::clone(void) const
+    {
+        return std::make_shared<StateBoundsCondition>(*this);
+    }
+
+    bool_t StateBoundsCondition::isTriggered(Model     const & model,
+                                             float64_t const & t,
+                                             vectorN_t const & x) const
+    {
+        auto const xSegment = x.segment(startIdx_, lowerBound_.size()).array();
+        return (xSegment < lowerBound_.array()).any() || (xSegment > upperBound_.array()).any();
+    }
+
+    std::shared_ptr<AbstractTerminationCondition> NanCondition::clone(void) const
+    {
+        return std::make_shared<NanCondition>(*this);
+    }
+
+    bool_t NanCondition::isTriggered(Model     const & model,
+                                     float64_t const & t,
+                                     vectorN_t const & x) const
+    {
+        return !x.allFinite(); // Either NaN or infinite
+    }
+
+    AbstractFrameCondition::AbstractFrameCondition(std::string const & frameName) :
+    AbstractTerminationCondition(),
+    frameName_(frameName),
+    frameIdx_(-1),
+    pncData_(pinocchio::Model())
+    {
+        // Empty.
+    }
+
+    result_t AbstractFrameCondition::initialize(Model const & model)
+    {
+        result_t returnCode = getFrameIdx(model.pncModel_, frameName_, frameIdx_);
+
+        if (returnCode == result_t::SUCCESS)
+        {
+            pncData_ = pinocchio::Data(model.pncModel_);
+        }
+
+        return returnCode;
+    }
+
+    pinocchio::SE3 const & AbstractFrameCondition::computeFramePlacement(Model     const & model,
+                                                                         vectorN_t const & x) const
+    {
+        pinocchio::forwardKinematics(model.pncModel_, pncData_, x.head(model.nq()));
+        return pinocchio::updateFramePlacement(model.pncModel_, pncData_, frameIdx_);
+    }
+
+    FrameHeightCondition::FrameHeightCondition(std::string const & frameName,
+                                               float64_t   const & heightMin) :
+    AbstractFrameCondition(frameName),
+    heightMin_(heightMin)
+    {
+        // Empty.
+    }
+
+    std::shared_ptr<AbstractTerminationCondition> FrameHeightCondition::clone(void) const
+    {
+        return std::make_shared<FrameHeightCondition>(*this);
+    }
+
+    bool_t FrameHeightCondition::isTriggered(Model     const & model,
+                                             float64_t const & t,
+                                             vectorN_t const & x) const
+    {
+        return computeFramePlacement(model, x).translation()[2] < heightMin_;
+    }
+
+    FrameOrientationCondition::FrameOrientationCondition(std::string const & frameName,
+                                                         float64_t   const & angleMax) :
+    AbstractFrameCondition(frameName),
+    cosAngleMax_(std::cos(angleMax))
+    {
+        // Empty.
+    }
+
+    std::shared_ptr<AbstractTerminationCondition> FrameOrientationCondition::clone(void) const
+    {
+        return std::make_shared<FrameOrientationCondition>(*this);
+    }
+
+    bool_t FrameOrientationCondition::isTriggered(Model     const & model,
+                                                  float64_t const & t,
+                                                  vectorN_t const & x) const
+    {
+        // Cosine of the angle between the vertical axes of the frame and the world
+        return computeFramePlacement(model, x).rotation()(2, 2) < cosAngleMax_;
+    }
+
+    WallClockCondition::WallClockCondition(float64_t const & durationMax) :
+    AbstractTerminationCondition(),
+    durationMax_(durationMax),
+    timer_()
+    {
+        // Empty.
+    }
+
+    result_t WallClockCondition::initialize(Model const & model)
+    {
+        timer_.tic();
+        return result_t::SUCCESS;
+    }
+
+    std::shared_ptr<AbstractTerminationCondition> WallClockCondition::clone(void) const
+    {
+        return std::make_shared<WallClockCondition>(*this);
+    }
+
+    bool_t WallClockCondition::isTriggered(Model     const & model,
+                                           float64_t const & t,
+                                           vectorN_t const & x) const
+    {
+        timer_.toc();
+        return timer_.dt > durationMax_;
+    }
+}
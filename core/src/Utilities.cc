@@ -17,14 +17,10 @@
 #include "pinocchio/algorithm/joint-configuration.hpp"
 
 #include "jiminy/core/Utilities.h"
-#include "jiminy/core/Engine.h"     // MIN_SIMULATION_TIMESTEP and MAX_SIMULATION_TIMESTEP
 
 
 namespace jiminy
 {
-    extern float64_t const MIN_SIMULATION_TIMESTEP;
-    extern float64_t const MAX_SIMULATION_TIMESTEP;
-
     // *************** Local Mutex/Lock mechanism ******************
 
     MutexLocal::MutexLocal(void) :
@@ -94,8 +90,29 @@ namespace jiminy
     // ***************** Random number generator *****************
     // Based on Ziggurat generator by Marsaglia and Tsang (JSS, 2000)
 
-    std::mt19937 generator_;
-    std::uniform_real_distribution<float32_t> distUniform_(0.0,1.0);
+    randomGeneratorState_t::randomGeneratorState_t(void) :
+    generator(),
+    philoxKey{0U, 0U},
+    philoxCounter(0U)
+    {
+        // Empty.
+    }
+
+    // The state is specific to each thread unless an engine provides its own
+    thread_local randomGeneratorState_t randomStateDefault_;
+    thread_local randomGeneratorState_t * randomState_ = &randomStateDefault_;
+    thread_local std::uniform_real_distribution<float32_t> distUniform_(0.0,1.0);
+
+    ScopedRandomGeneratorState::ScopedRandomGeneratorState(randomGeneratorState_t & state) :
+    statePrevious_(randomState_)
+    {
+        randomState_ = &state;
+    }
+
+    ScopedRandomGeneratorState::~ScopedRandomGeneratorState(void)
+    {
+        randomState_ = statePrevious_;
+    }
 
     uint32_t kn[128];
     float32_t fn[128];
@@ -129,9 +146,12 @@ namespace jiminy
         }
     }
 
+    // The tables are shared by every thread, so they must be computed once and for all
+    bool_t const isZigguratSetup_ = (r4_nor_setup(), true);
+
     float32_t r4_uni(void)
     {
-        return distUniform_(generator_);
+        return distUniform_(randomState_->generator);
     }
 
     float32_t r4_nor(void)
@@ -142,7 +162,7 @@ namespace jiminy
         float32_t x;
         float32_t y;
 
-        hz = static_cast<int32_t>(generator_());
+        hz = static_cast<int32_t>(randomState_->generator());
         iz = (hz & 127U);
 
         if (fabs(hz) < kn[iz])
@@ -182,7 +202,7 @@ namespace jiminy
                     return x;
                 }
 
-                hz = static_cast<int32_t>(generator_());
+                hz = static_cast<int32_t>(randomState_->generator());
                 iz = (hz & 127);
 
                 if (fabs(hz) < kn[iz])
@@ -193,15 +213,56 @@ namespace jiminy
         }
     }
 
+    // ************ Counter-based random number generator **************
+    // Based on Philox4x32-10 by Salmon et al. (SC, 2011)
+
+    /* Every block of random numbers only depends on the key and its index, so that they can
+       be generated independently of each other, in bulk. */
+    void philox4x32(uint32_t const (&keyInit)[2],
+                    uint64_t const & counter,
+                    uint32_t       (&block)[4])
+    {
+        uint32_t key[2] = {keyInit[0], keyInit[1]};
+        block[0] = static_cast<uint32_t>(counter);
+        block[1] = static_cast<uint32_t>(counter >> 32);
+        block[2] = 0U;
+        block[3] = 0U;
+        for (uint8_t i = 0; i < 10; i++)
+        {
+            uint64_t const prod0 = static_cast<uint64_t>(0xD2511F53U) * block[0];
+            uint64_t const prod1 = static_cast<uint64_t>(0xCD9E8D57U) * block[2];
+            uint32_t const block1 = block[1];
+            block[0] = static_cast<uint32_t>(prod1 >> 32) ^ block1 ^ key[0];
+            block[1] = static_cast<uint32_t>(prod1);
+            block[2] = static_cast<uint32_t>(prod0 >> 32) ^ block[3] ^ key[1];
+            block[3] = static_cast<uint32_t>(prod0);
+            key[0] += 0x9E3779B9U;
+            key[1] += 0xBB67AE85U;
+        }
+    }
+
     // ************** Random number generator utilities ****************
 
 	void resetRandGenerators(uint32_t seed)
 	{
 		srand(seed); // Eigen relies on srand for genering random matrix
-        generator_.seed(seed);
-        r4_nor_setup();
+        randomStateDefault_.generator.seed(seed);
+        randomStateDefault_.philoxKey[0] = seed;
+        randomStateDefault_.philoxKey[1] = 0U;
+        randomStateDefault_.philoxCounter = 0U;
 	}
 
+    void resetRandGenerators(randomGeneratorState_t       & state,
+                             uint32_t               const & seed,
+                             uint32_t               const & streamIdx)
+    {
+        std::seed_seq seedSequence{seed, streamIdx};
+        state.generator.seed(seedSequence);
+        state.philoxKey[0] = seed;
+        state.philoxKey[1] = streamIdx;
+        state.philoxCounter = 0U;
+    }
+
 	float64_t randUniform(float64_t const & lo,
 	                      float64_t const & hi)
     {
@@ -257,6 +318,33 @@ namespace jiminy
         });
     }
 
+    void randMatrixNormal(matrixN_t & samples)
+    {
+        float64_t const uintToUnit = 1.0 / 4294967296.0;
+        float64_t const twoPi = 2.0 * M_PI;
+
+        // Each block of four integers gives two pairs of standard normal samples (Box-Muller)
+        float64_t * sample = samples.data();
+        int32_t const size = static_cast<int32_t>(samples.size());
+        for (int32_t i = 0; i < size; i += 4)
+        {
+            uint32_t block[4];
+            philox4x32(randomState_->philoxKey, randomState_->philoxCounter++, block);
+
+            float64_t normals[4];
+            for (uint8_t j = 0; j < 4; j += 2)
+            {
+                float64_t const radius = std::sqrt(-2.0 * std::log((block[j] + 0.5) * uintToUnit));
+                float64_t const angle = twoPi * block[j + 1] * uintToUnit;
+                normals[j] = radius * std::cos(angle);
+                normals[j + 1] = radius * std::sin(angle);
+            }
+
+            int32_t const numSamples = std::min(size - i, 4);
+            std::copy(normals, normals + numSamples, sample + i);
+        }
+    }
+
     // ******************* Telemetry utilities **********************
 
     std::vector<std::string> defaultVectorFieldnames(std::string const & baseName,
@@ -301,17 +389,81 @@ namespace jiminy
     void computePositionDerivative(pinocchio::Model            const & model,
                                    Eigen::Ref<vectorN_t const>         q,
                                    Eigen::Ref<vectorN_t const>         v,
-                                   Eigen::Ref<vectorN_t>               qDot,
-                                   float64_t                           dt)
+                                   Eigen::Ref<vectorN_t>               qDot)
     {
-        /* Hack to compute the configuration vector derivative, including the
-           quaternions on SO3 automatically. Note that the time difference must
-           not be too small to avoid failure. */
+        /* Compute the configuration vector derivative analytically for each joint.
+           Note that the velocity is expressed in the local frame of the joint, and
+           the quaternions are stored as (x, y, z, w) by Pinocchio. */
+
+        std::vector<int32_t> genericJointsIdx;
+        for (int32_t i = 1; i < model.njoints; i++)
+        {
+            auto const & joint = model.joints[i];
+            auto const & jointVariant = joint.toVariant();
+            int32_t const & idx_q = joint.idx_q();
+            int32_t const & idx_v = joint.idx_v();
 
-        dt = std::max(MIN_SIMULATION_TIMESTEP, dt);
-        vectorN_t qNext(q.size());
-        pinocchio::integrate(model, q, v*dt, qNext);
-        qDot = (qNext - q) / dt;
+            if (boost::get<pinocchio::JointModelFreeFlyer>(&jointVariant)
+             || boost::get<pinocchio::JointModelSpherical>(&jointVariant))
+            {
+                // The quaternion is stored last, after the translation for freeflyer joints
+                int32_t const quatIdx = idx_q + joint.nq() - 4;
+                Eigen::Map<quaternion_t const> const quat(q.data() + quatIdx);
+                auto const omega = v.segment<3>(idx_v + joint.nv() - 3);
+                if (joint.nq() == 7)
+                {
+                    qDot.segment<3>(idx_q) = quat._transformVector(v.segment<3>(idx_v));
+                }
+                qDot.segment<3>(quatIdx) = 0.5 * (quat.w() * omega + quat.vec().cross(omega));
+                qDot[quatIdx + 3] = - 0.5 * quat.vec().dot(omega);
+            }
+            else if (boost::get<pinocchio::JointModelPlanar>(&jointVariant))
+            {
+                // The orientation is stored as (cos, sin)
+                float64_t const & cosTheta = q[idx_q + 2];
+                float64_t const & sinTheta = q[idx_q + 3];
+                float64_t const & omega = v[idx_v + 2];
+                qDot[idx_q] = cosTheta * v[idx_v] - sinTheta * v[idx_v + 1];
+                qDot[idx_q + 1] = sinTheta * v[idx_v] + cosTheta * v[idx_v + 1];
+                qDot[idx_q + 2] = - sinTheta * omega;
+                qDot[idx_q + 3] = cosTheta * omega;
+            }
+            else if (boost::get<pinocchio::JointModelRUBX>(&jointVariant)
+                  || boost::get<pinocchio::JointModelRUBY>(&jointVariant)
+                  || boost::get<pinocchio::JointModelRUBZ>(&jointVariant))
+            {
+                // Unbounded rotary joints: the angle is stored as (cos, sin)
+                float64_t const & omega = v[idx_v];
+                qDot[idx_q] = - q[idx_q + 1] * omega;
+                qDot[idx_q + 1] = q[idx_q] * omega;
+            }
+            else if (joint.nq() == joint.nv())
+            {
+                // Euclidean joints: linear and rotary
+                qDot.segment(idx_q, joint.nq()) = v.segment(idx_v, joint.nv());
+            }
+            else
+            {
+                genericJointsIdx.push_back(i);
+            }
+        }
+
+        /* Any other joint is handled by differentiating numerically the integration
+           of Pinocchio. It is only meant as a fallback since it is much slower. */
+        if (!genericJointsIdx.empty())
+        {
+            float64_t const dt = 1.0e-6;
+            vectorN_t qPlus(model.nq);
+            vectorN_t qMinus(model.nq);
+            pinocchio::integrate(model, q, dt * v, qPlus);
+            pinocchio::integrate(model, q, - dt * v, qMinus);
+            for (int32_t const & i : genericJointsIdx)
+            {
+                auto const & joint = model.joints[i];
+                qDot.segment(joint.idx_q(), joint.nq()) =
+                    (qPlus.segment(joint.idx_q(), joint.nq()) - qMinus.segment(joint.idx_q(), joint.nq())) / (2 * dt);
+            }
+        }
     }
 
     result_t getJointNameFromPositionId(pinocchio::Model const & model,
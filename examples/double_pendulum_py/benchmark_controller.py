@@ -0,0 +1,87 @@
+import os
+import time
+import numpy as np
+
+from jiminy_py import core as jiminy
+
+
+# ################################ User parameters #######################################
+
+os.environ["JIMINY_MESH_PATH"] = os.path.join(os.environ["HOME"], "wdc_workspace/src/jiminy/data")
+urdf_path = os.path.join(os.environ["JIMINY_MESH_PATH"], "double_pendulum/double_pendulum.urdf")
+
+tf = 10.0
+n_repeat = 5
+
+# ########################### Initialize the simulation #################################
+
+def make_model():
+    model = jiminy.Model()
+    model.initialize(urdf_path, False)
+    motor = jiminy.SimpleMotor("SecondPendulumJoint")
+    model.attach_motor(motor)
+    motor.initialize("SecondPendulumJoint")
+    encoder = jiminy.EncoderSensor("SecondPendulumJoint")
+    model.attach_sensor(encoder)
+    encoder.initialize("SecondPendulumJoint")
+    return model
+
+def configure_engine(engine):
+    # Continuous-time controller, so that the controller is called at every stage of the stepper
+    engine_options = engine.get_options()
+    engine_options["telemetry"]["enableConfiguration"] = False
+    engine_options["telemetry"]["enableVelocity"] = False
+    engine_options["telemetry"]["enableAcceleration"] = False
+    engine_options["telemetry"]["enableTorque"] = False
+    engine_options["telemetry"]["enableEnergy"] = False
+    engine_options["stepper"]["odeSolver"] = "runge_kutta_dopri5"
+    engine_options["stepper"]["sensorsUpdatePeriod"] = 0.0
+    engine_options["stepper"]["controllerUpdatePeriod"] = 0.0
+    engine.set_options(engine_options)
+
+x0 = np.zeros((4,))
+x0[1] = 0.1
+
+# Python controller, doing nothing but counting the calls
+n_calls = 0
+def computeCommand(t, q, v, sensor_data, u):
+    global n_calls
+    n_calls += 1
+    u[0] = 0.0
+
+def internalDynamics(t, q, v, sensor_data, u):
+    pass
+
+model_py = make_model()
+controller = jiminy.ControllerFunctor(computeCommand, internalDynamics)
+controller.initialize(model_py)
+engine_py = jiminy.Engine()
+engine_py.initialize(model_py, controller)
+configure_engine(engine_py)
+
+# Native controller, applying a constant command
+engine_native = jiminy.EngineBatch()
+engine_native.initialize([make_model()], 1)
+configure_engine(engine_native[0])
+
+# ############################## Run the benchmark #####################################
+
+duration_py = float('inf')
+for _ in range(n_repeat):
+    n_calls = 0
+    start = time.perf_counter()
+    engine_py.simulate(tf, x0)
+    duration_py = min(time.perf_counter() - start, duration_py)
+
+duration_native = float('inf')
+u_command = np.zeros((1, engine_native.nu))
+for _ in range(n_repeat):
+    start = time.perf_counter()
+    engine_native.start(x0[np.newaxis])
+    engine_native.step(u_command, tf)
+    engine_native.stop()
+    duration_native = min(time.perf_counter() - start, duration_native)
+
+print("Python controller: %03.0fms (%i calls)" % (duration_py * 1.0e3, n_calls))
+print("Native controller: %03.0fms" % (duration_native * 1.0e3))
+print("Overhead per call: %.2fus" % ((duration_py - duration_native) / n_calls * 1.0e6))
@@ -111,7 +111,7 @@ class RobotJiminyEnv(core.Env):
         """
         self.np_random, seed = seeding.np_random(seed)
         self.engine_py.seed(seed)
-        self.state = self.engine_py.state
+        self.state = self.engine_py.state.copy()
         return [seed]
 
     def reset(self):
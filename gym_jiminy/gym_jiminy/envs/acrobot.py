@@ -226,7 +226,7 @@ class JiminyAcrobotGoalEnv(RobotJiminyGoalEnv):
         # Bypass 'self.engine_py.step' method and use direct assignment to max out the performances
         self.engine_py._action[0] = torque
         self.engine_py.step(dt_desired=self.dt)
-        self.state = self.engine_py.state
+        self.state = self.engine_py.state.copy()
 
         # Get information
         info, obs = self._get_info()
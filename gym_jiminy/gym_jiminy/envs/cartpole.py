@@ -182,7 +182,7 @@ class JiminyCartPoleEnv(RobotJiminyEnv):
         else:
             self.engine_py._action[0] = -self.force_mag
         self.engine_py.step(dt_desired=self.dt)
-        self.state = self.engine_py.state
+        self.state = self.engine_py.state.copy()
 
         # Check the terminal condition and compute reward
         done = self._is_success()
@@ -79,7 +79,7 @@ class EngineAsynchronous(object):
                     manually.
         """
         for sensor_type in self._sensors_types:
-            self._observation[sensor_type] = sensor_data[sensor_type]
+            self._observation[sensor_type] = sensor_data[sensor_type].copy()
         uCommand[:] = self._action
 
     def _internal_dynamics(self, t, q, v, sensor_data, uCommand):
@@ -205,6 +205,10 @@ class EngineAsynchronous(object):
         """
         @brief      Getter of the current state of the robot.
 
+        @remark     Once the simulation is running, it is a read-only view on the
+                    internal state of the engine, which is updated in place at each
+                    step. It must be copied to keep track of a given state.
+
         @return     State of the robot
         """
         if (self._state is None):
@@ -221,6 +225,10 @@ class EngineAsynchronous(object):
         """
         @brief      Getter of the current state of the sensors.
 
+        @remark     The values are read-only views on the sensor data, which are
+                    updated in place at each step. They must be copied to keep track
+                    of a given observation.
+
         @return     Dictionary whose the keys are the different class of sensors
                     available.
                     (row: data, column: sensor).
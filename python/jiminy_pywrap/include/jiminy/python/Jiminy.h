@@ -8,12 +8,15 @@
 #include <cassert>
 
 #include "jiminy/core/Engine.h"
+#include "jiminy/core/EngineBatch.h"
+#include "jiminy/core/Environment.h"
 #include "jiminy/core/BasicMotors.h"
 #include "jiminy/core/BasicSensors.h"
 #include "jiminy/core/Model.h"
 #include "jiminy/core/AbstractController.h"
 #include "jiminy/core/ControllerFunctor.h"
 #include "jiminy/core/TelemetryData.h"
+#include "jiminy/core/TelemetryDataset.h"
 #include "jiminy/core/Types.h"
 
 #include "jiminy/python/Utilities.h"
@@ -42,7 +45,7 @@ namespace python
 
     public:
         TimeStateFctPyWrapper(bp::object const& objPy) :
-        funcPyPtr_(objPy),
+        funcPyPtr_(bp::incref(objPy.ptr())),
         outPtr_(new T),
         outPyPtr_()
         {
@@ -51,7 +54,7 @@ namespace python
 
         // Copy constructor, same as the normal constructor
         TimeStateFctPyWrapper(TimeStateFctPyWrapper const & other) :
-        funcPyPtr_(other.funcPyPtr_),
+        funcPyPtr_(bp::incref(other.funcPyPtr_)),
         outPtr_(new T),
         outPyPtr_()
         {
@@ -61,16 +64,18 @@ namespace python
 
         // Move constructor, takes a rvalue reference &&
         TimeStateFctPyWrapper(TimeStateFctPyWrapper&& other) :
-        funcPyPtr_(other.funcPyPtr_),
+        funcPyPtr_(nullptr),
         outPtr_(nullptr),
         outPyPtr_(nullptr)
         {
             // Steal the resource from "other"
+            funcPyPtr_ = other.funcPyPtr_;
             outPtr_ = other.outPtr_;
             outPyPtr_ = other.outPyPtr_;
 
             /* "other" will soon be destroyed and its destructor will
                do nothing because we null out its resource here */
+            other.funcPyPtr_ = nullptr;
             other.outPtr_ = nullptr;
             other.outPyPtr_ = nullptr;
         }
@@ -78,7 +83,14 @@ namespace python
         // Destructor
         ~TimeStateFctPyWrapper()
         {
-            Py_XDECREF(outPyPtr_);
+            /* The engine may destroy the wrapper while the GIL is released, for
+               instance when the force profiles are cleared by Engine::start. */
+            if (funcPyPtr_ || outPyPtr_)
+            {
+                ScopedGILAcquire gilLock;
+                Py_XDECREF(funcPyPtr_);
+                Py_XDECREF(outPyPtr_);
+            }
             delete outPtr_;
         }
 
@@ -96,15 +108,18 @@ namespace python
         T const & operator() (float64_t const & t,
                               vectorN_t const & x)
         {
+            // The GIL may have been released by the engine
+            ScopedGILAcquire gilLock;
+
             // Pass the arguments by reference (be careful const qualifiers are lost)
             bp::handle<> xPy(getNumpyReferenceFromEigenVector(x));
             bp::handle<> outPy(bp::borrowed(outPyPtr_));
-            funcPyPtr_(t, xPy, outPy);
+            bp::call<void>(funcPyPtr_, t, xPy, outPy);
             return *outPtr_;
         }
 
     private:
-        bp::object funcPyPtr_;
+        PyObject * funcPyPtr_;  ///< Owned reference, released with the GIL held
         T * outPtr_;
         PyObject * outPyPtr_;
     };
@@ -215,11 +230,14 @@ namespace python
 
             if (heatMapType_ == heatMapType_t::STAIRS)
             {
+                ScopedGILAcquire gilLock;
+
                 bp::handle<> out1Py(bp::borrowed(out1PyPtr_));
                 handlePyPtr_(posFrame[0], posFrame[1], out1Py);
             }
             else if (heatMapType_ == heatMapType_t::GENERIC)
             {
+                ScopedGILAcquire gilLock;
                 bp::handle<> out1Py(bp::borrowed(out1PyPtr_));
                 bp::handle<> out2Py(bp::borrowed(out2PyPtr_));
                 handlePyPtr_(posFrame[0], posFrame[1], out1Py, out2Py);
@@ -340,8 +358,7 @@ namespace python
             {
                 auto & sensorDataTypeByName = self.at(sensorType).get<IndexByName>();
                 auto sensorDataIt = sensorDataTypeByName.find(sensorName);
-                vectorN_t const * sensorDataValue = sensorDataIt->value;
-                bp::handle<> valuePy(getNumpyReferenceFromEigenVector(*sensorDataValue));
+                bp::handle<> valuePy(makeNumpyReadOnly(getNumpyReferenceFromEigenVector(sensorDataIt->value)));
                 return bp::object(valuePy);
             }
             catch (...)
@@ -351,21 +368,26 @@ namespace python
             }
         }
 
-        static matrixN_t getSub(sensorsDataMap_t       & self,
-                                std::string      const & sensorType)
+        ///////////////////////////////////////////////////////////////////////////////
+        /// \brief     Get the data of every sensor of a given type (row: data, column: sensor).
+        ///
+        /// \details   It is a read-only view on the measurements, which are stored contiguously
+        ///            for a given type of sensor, ordered by sensor index. The view is updated in
+        ///            place during the simulation, and remains valid as long as the model exists
+        ///            and no sensor of this type is attached or detached.
+        ///////////////////////////////////////////////////////////////////////////////
+        static bp::object getSub(sensorsDataMap_t       & self,
+                                 std::string      const & sensorType)
         {
-            // Extract the encoder data matrix
             auto const & sensorsDataType = self.at(sensorType);
-            matrixN_t data;
-            auto sensorDataIt = sensorsDataType.begin();
-            data.resize(sensorDataIt->value->size(), sensorsDataType.size());
-            data.col(sensorDataIt->id) = *sensorDataIt->value;
-            ++sensorDataIt;
-            for (; sensorDataIt != sensorsDataType.end(); ++sensorDataIt)
+            if (sensorsDataType.empty())
             {
-                data.col(sensorDataIt->id) = *sensorDataIt->value;
+                return bp::object(bp::handle<>(getNumpyReferenceFromEigenMatrix(matrixN_t())));
             }
-            return data;
+            Eigen::Ref<vectorN_t const> const & sensorDataFirst = sensorsDataType.begin()->value;
+            Eigen::Map<matrixN_t const> data(sensorDataFirst.data(), sensorDataFirst.size(), sensorsDataType.size());
+            assert(sensorsDataType.rbegin()->value.data() == data.col(data.cols() - 1).data());
+            return bp::object(bp::handle<>(makeNumpyReadOnly(getNumpyReferenceFromEigenMatrix(data))));
         }
 
         static bool_t contains(sensorsDataMap_t       & self,
@@ -445,21 +467,87 @@ namespace python
     struct ControllerFctWrapper
     {
     public:
-        ControllerFctWrapper(bp::object const & objPy) : funcPyPtr_(objPy) {}
+        // Disable the copy of the class
+        ControllerFctWrapper & operator = (ControllerFctWrapper const & other) = delete;
+
+    public:
+        ControllerFctWrapper(bp::object const & objPy) :
+        funcPyPtr_(objPy),
+        argsPy_()
+        {
+            // Empty on purpose.
+        }
+
+        // Copy constructor, the persistent arguments are not shared since they refer to internal buffers
+        ControllerFctWrapper(ControllerFctWrapper const & other) :
+        funcPyPtr_(other.funcPyPtr_),
+        argsPy_()
+        {
+            // Empty on purpose.
+        }
+
+        ControllerFctWrapper(ControllerFctWrapper && other) = default;
+
         void operator() (float64_t        const & t,
                          vectorN_t        const & q,
                          vectorN_t        const & v,
                          sensorsDataMap_t const & sensorsData,
                          vectorN_t              & uCommand)
         {
-            // Pass the arguments by reference (be careful const qualifiers are lost).
-            bp::handle<> qPy(getNumpyReferenceFromEigenVector(q));
-            bp::handle<> vPy(getNumpyReferenceFromEigenVector(v));
-            bp::handle<> uCommandPy(getNumpyReferenceFromEigenVector(uCommand));
-            funcPyPtr_(t, qPy, vPy, boost::ref(sensorsData), uCommandPy);
+            // The GIL may have been released by the engine
+            ScopedGILAcquire gilLock;
+
+            /* Pass the arguments by reference through persistent numpy arrays, so that
+               no Python object is created at each call (be careful const qualifiers are
+               lost). The arrays are views on internal buffers, since there is no guarantee
+               that the arguments are stored at the same place from one call to another. */
+            if (!argsPy_)
+            {
+                argsPy_ = std::make_unique<persistentArgsPy_t>();
+            }
+            updateArgPy(q, argsPy_->q, argsPy_->qPy);
+            updateArgPy(v, argsPy_->v, argsPy_->vPy);
+            updateArgPy(uCommand, argsPy_->uCommand, argsPy_->uCommandPy);
+            if (argsPy_->sensorsData != &sensorsData)
+            {
+                argsPy_->sensorsData = &sensorsData;
+                argsPy_->sensorsDataPy = bp::object(boost::ref(sensorsData));
+            }
+
+            funcPyPtr_(t, argsPy_->qPy, argsPy_->vPy, argsPy_->sensorsDataPy, argsPy_->uCommandPy);
+
+            uCommand = argsPy_->uCommand;
         }
+
+    private:
+        struct persistentArgsPy_t
+        {
+            vectorN_t q;
+            vectorN_t v;
+            vectorN_t uCommand;
+            bp::object qPy;
+            bp::object vPy;
+            bp::object uCommandPy;
+            sensorsDataMap_t const * sensorsData;
+            bp::object sensorsDataPy;
+        };
+
+        static void updateArgPy(vectorN_t  const & arg,
+                                vectorN_t        & argBuffer,
+                                bp::object       & argPy)
+        {
+            // The view must only be created again if the buffer is reallocated
+            if (argBuffer.size() != arg.size() || argPy.is_none())
+            {
+                argBuffer.resize(arg.size());
+                argPy = bp::object(bp::handle<>(getNumpyReferenceFromEigenVector(argBuffer)));
+            }
+            argBuffer = arg;
+        }
+
     private:
         bp::object funcPyPtr_;
+        std::unique_ptr<persistentArgsPy_t> argsPy_;    ///< Persistent arguments, created at the first call
     };
 
     // ***************************** PyMotorVisitor ***********************************
@@ -739,9 +827,12 @@ namespace python
         void visit(PyClass& cl) const
         {
             cl
-                .def("initialize", &Model::initialize,
+                .def("initialize", static_cast<result_t (Model::*)(std::string const &, bool_t const &, std::string const &)>(&Model::initialize),
                                    (bp::arg("self"), "urdf_path",
-                                    bp::arg("has_freeflyer") = false))
+                                    bp::arg("has_freeflyer") = false,
+                                    bp::arg("cache_path") = std::string()))
+                .def("initialize", &PyModelVisitor::initializeShared,
+                                   (bp::arg("self"), "model"))
 
                 .def("add_contact_points", &PyModelVisitor::addContactPoints,
                                            (bp::arg("self"),
@@ -770,6 +861,10 @@ namespace python
                                     bp::return_value_policy<bp::reference_existing_object>())
 
                 .add_property("sensors_data", &PyModelVisitor::getSensorsData)
+                .add_property("sensors_data_flat", bp::make_function(&Model::getSensorsDataFlat,
+                                                   bp::return_value_policy<bp::copy_const_reference>()))
+                .def("get_sensors_data_segment", &PyModelVisitor::getSensorsDataSegment,
+                                                 (bp::arg("self"), "sensor_type"))
                 .add_property("motors_torques", bp::make_function(&Model::getMotorsTorques,
                                                 bp::return_value_policy<bp::copy_const_reference>()))
 
@@ -787,8 +882,9 @@ namespace python
                                                  bp::return_internal_reference<>()))
                 .add_property("pinocchio_data", bp::make_getter(&Model::pncData_,
                                                 bp::return_internal_reference<>()))
-                .add_property("pinocchio_model_th", bp::make_getter(&Model::pncModelRigidOrig_,
-                                                    bp::return_internal_reference<>()))
+                // The rigid model is shared by every model loaded from the same URDF, so that it is copied to remain read-only
+                .add_property("pinocchio_model_th", bp::make_function(&Model::getModelRigidOrig,
+                                                    bp::return_value_policy<bp::copy_const_reference>()))
                 .add_property("pinocchio_data_th", bp::make_getter(&Model::pncDataRigidOrig_,
                                                    bp::return_internal_reference<>()))
 
@@ -844,6 +940,22 @@ namespace python
                 ;
         }
 
+        ///////////////////////////////////////////////////////////////////////////////
+        /// \brief      Initialize the model from the description of another one.
+        ///
+        /// \details    The URDF file is not parsed again, and the kinematic tree is shared.
+        ///////////////////////////////////////////////////////////////////////////////
+        static result_t initializeShared(Model       & self,
+                                         Model const & model)
+        {
+            if (!model.getIsInitialized())
+            {
+                std::cout << "Error - PyModelVisitor::initializeShared - The other model is not initialized." << std::endl;
+                return result_t::ERROR_INIT_FAILED;
+            }
+            return self.initialize(model.getDescription());
+        }
+
         static result_t detachMotors(Model          & self,
                                      bp::list const & jointNamesPy)
         {
@@ -874,6 +986,19 @@ namespace python
             return boost::make_shared<sensorsDataMap_t>(self.getSensorsData());
         }
 
+        static bp::tuple getSensorsDataSegment(Model             & self,
+                                               std::string const & sensorType)
+        {
+            uint32_t offset = 0;
+            uint32_t size = 0;
+            if (self.getSensorsDataSegment(sensorType, offset, size) != result_t::SUCCESS)
+            {
+                PyErr_SetString(PyExc_KeyError, ("No sensor of type '" + sensorType + "'.").c_str());
+                bp::throw_error_already_set();
+            }
+            return bp::make_tuple(offset, size);
+        }
+
         static AbstractMotorBase const * getMotor(Model             & self,
                                                   std::string const & motorName)
         {
@@ -1231,57 +1356,64 @@ namespace python
                 .def_readonly("iter", &stepperState_t::iter)
                 .def_readonly("t", &stepperState_t::t)
                 .def_readonly("dt", &stepperState_t::dt)
-                .add_property("x", bp::make_getter(&stepperState_t::x,
-                                   bp::return_value_policy<bp::copy_non_const_reference>()))
-                .add_property("q", bp::make_function(&PyStepperVisitor::q,
-                                   bp::return_value_policy<bp::return_by_value>()))
-                .add_property("v", bp::make_function(&PyStepperVisitor::v,
-                                   bp::return_value_policy<bp::return_by_value>()))
-                .add_property("dxdt", bp::make_getter(&stepperState_t::dxdt,
-                                      bp::return_value_policy<bp::copy_non_const_reference>()))
-                .add_property("qDot", bp::make_function(&PyStepperVisitor::qDot,
-                                      bp::return_value_policy<bp::return_by_value>()))
-                .add_property("a", bp::make_function(&PyStepperVisitor::a,
-                                   bp::return_value_policy<bp::return_by_value>()))
-                .add_property("u", bp::make_getter(&stepperState_t::u,
-                                   bp::return_value_policy<bp::copy_non_const_reference>()))
-                .add_property("u_motor", bp::make_getter(&stepperState_t::uMotor,
-                                           bp::return_value_policy<bp::copy_non_const_reference>()))
-                .add_property("u_command", bp::make_getter(&stepperState_t::uCommand,
-                                           bp::return_value_policy<bp::copy_non_const_reference>()))
-                .add_property("u_internal", bp::make_getter(&stepperState_t::uInternal,
-                                            bp::return_value_policy<bp::copy_non_const_reference>()))
+                .add_property("x", &PyStepperVisitor::getVector<&stepperState_t::x>)
+                .add_property("q", &PyStepperVisitor::q)
+                .add_property("v", &PyStepperVisitor::v)
+                .add_property("dxdt", &PyStepperVisitor::getVector<&stepperState_t::dxdt>)
+                .add_property("qDot", &PyStepperVisitor::qDot)
+                .add_property("a", &PyStepperVisitor::a)
+                .add_property("u", &PyStepperVisitor::getVector<&stepperState_t::u>)
+                .add_property("u_motor", &PyStepperVisitor::getVector<&stepperState_t::uMotor>)
+                .add_property("u_command", &PyStepperVisitor::getVector<&stepperState_t::uCommand>)
+                .add_property("u_internal", &PyStepperVisitor::getVector<&stepperState_t::uInternal>)
                 .add_property("f_external", bp::make_getter(&stepperState_t::fExternal,
                                             bp::return_value_policy<bp::copy_non_const_reference>()))
                 ;
         }
 
-        static vectorN_t q(stepperState_t & self)
+        ///////////////////////////////////////////////////////////////////////////////
+        /// \brief     Get a read-only view on a buffer of the stepper.
+        ///
+        /// \details   The buffers are updated in place by the engine after every step, so one
+        ///            must copy the view to keep track of a given value. The view keeps the
+        ///            engine alive, and remains valid as long as the dimensions of the model
+        ///            are unchanged.
+        ///////////////////////////////////////////////////////////////////////////////
+        static bp::object getVectorView(bp::object                  const & selfPy,
+                                        Eigen::Ref<vectorN_t const>         data)
         {
-            // Eigenpy is not able to convert automatically a Eigen::Ref object
-
-            return self.q();
+            return bp::object(bp::handle<>(makeNumpyReadOnly(getNumpyReferenceFromEigenVector(data), selfPy.ptr())));
         }
 
-        static vectorN_t v(stepperState_t & self)
+        template<vectorN_t stepperState_t::* member>
+        static bp::object getVector(bp::object const & selfPy)
         {
-            // Eigenpy is not able to convert automatically a Eigen::Ref object
-
-            return self.v();
+            stepperState_t & self = bp::extract<stepperState_t &>(selfPy);
+            return getVectorView(selfPy, self.*member);
         }
 
-        static vectorN_t qDot(stepperState_t & self)
+        static bp::object q(bp::object const & selfPy)
         {
-            // Eigenpy is not able to convert automatically a Eigen::Ref object
+            stepperState_t & self = bp::extract<stepperState_t &>(selfPy);
+            return getVectorView(selfPy, self.q());
+        }
 
-            return self.qDot();
+        static bp::object v(bp::object const & selfPy)
+        {
+            stepperState_t & self = bp::extract<stepperState_t &>(selfPy);
+            return getVectorView(selfPy, self.v());
         }
 
-        static vectorN_t a(stepperState_t & self)
+        static bp::object qDot(bp::object const & selfPy)
         {
-            // Eigenpy is not able to convert automatically a Eigen::Ref object
+            stepperState_t & self = bp::extract<stepperState_t &>(selfPy);
+            return getVectorView(selfPy, self.qDot());
+        }
 
-            return self.a();
+        static bp::object a(bp::object const & selfPy)
+        {
+            stepperState_t & self = bp::extract<stepperState_t &>(selfPy);
+            return getVectorView(selfPy, self.a());
         }
 
         ///////////////////////////////////////////////////////////////////////////////
@@ -1317,7 +1449,7 @@ namespace python
                 .def("reset", static_cast<void (Engine::*)(bool_t const &)>(&Engine::reset),
                               (bp::arg("self"),
                                bp::arg("remove_forces") = false))
-                .def("start", &Engine::start,
+                .def("start", &PyEngineVisitor::start,
                               (bp::arg("self"), "x_init",
                                bp::arg("is_state_theoretical") = false,
                                bp::arg("reset_random_generator") = false,
@@ -1326,7 +1458,7 @@ namespace python
                              (bp::arg("self"),
                               bp::arg("dt_desired") = -1))
                 .def("stop", &Engine::stop, (bp::arg("self")))
-                .def("simulate", &Engine::simulate,
+                .def("simulate", &PyEngineVisitor::simulate,
                                  (bp::arg("self"), "end_time", "x_init",
                                   bp::arg("is_state_theoretical") = false))
 
@@ -1336,12 +1468,25 @@ namespace python
                                    bp::arg("isModeBinary") = true))
                 .def("read_log", &PyEngineVisitor::parseLogBinary, (bp::arg("filename")))
                 .staticmethod("read_log")
+                .def("write_log_dataset", &Engine::writeLogDataset,
+                                          (bp::arg("self"), "dataset"))
 
                 .def("register_force_impulse", &Engine::registerForceImpulse,
                                                (bp::arg("self"), "frame_name", "t", "dt", "F"))
                 .def("register_force_profile", &PyEngineVisitor::registerForceProfile,
                                                (bp::arg("self"), "frame_name", "force_handle"))
+                .def("register_force_profile_tabulated", &Engine::registerForceProfileTabulated,
+                                                         (bp::arg("self"), "frame_name", "t", "F"))
+                .def("register_force_profile_polynomial", &Engine::registerForceProfilePolynomial,
+                                                          (bp::arg("self"), "frame_name", "breakpoints", "coefficients"))
                 .def("remove_forces", &PyEngineVisitor::removeForces)
+                .def("add_stop_condition", &Engine::addStopCondition,
+                                           (bp::arg("self"), "condition"))
+                .def("remove_stop_conditions", &Engine::removeStopConditions)
+                .def("set_domain_randomization", &PyEngineVisitor::setDomainRandomization,
+                                                 (bp::arg("self"), "domain_randomization"))
+                .def("set_random_stream_idx", &Engine::setRandomStreamIdx,
+                                              (bp::arg("self"), "stream_idx"))
 
                 .def("get_options", &PyEngineVisitor::getOptions,
                                     bp::return_value_policy<bp::return_by_value>())
@@ -1377,13 +1522,42 @@ namespace python
             return self.initialize(model, controller, std::move(callbackFct));
         }
 
+        ///////////////////////////////////////////////////////////////////////////////
+        /// \brief      Run the native integration without holding the GIL.
+        ///
+        /// \details    The GIL is only acquired back by the Python callbacks, if any, so
+        ///             that several engines can run concurrently in separate Python threads.
+        ///             The Python force profiles cleared by the reset release their
+        ///             references after acquiring the GIL back.
+        ///////////////////////////////////////////////////////////////////////////////
+        static result_t start(Engine          & self,
+                              vectorN_t const & xInit,
+                              bool_t    const & isStateTheoretical,
+                              bool_t    const & resetRandomNumbers,
+                              bool_t    const & resetDynamicForceRegister)
+        {
+            ScopedGILRelease gilRelease;
+            return self.start(xInit, isStateTheoretical, resetRandomNumbers, resetDynamicForceRegister);
+        }
+
         static result_t step(Engine          & self,
                              float64_t const & dtDesired)
         {
+            ScopedGILRelease gilRelease;
+
             // Only way to handle C++ default values that are not accessible in Python
             return self.step(dtDesired);
         }
 
+        static result_t simulate(Engine          & self,
+                                 float64_t const & endTime,
+                                 vectorN_t const & xInit,
+                                 bool_t    const & isStateTheoretical)
+        {
+            ScopedGILRelease gilRelease;
+            return self.simulate(endTime, xInit, isStateTheoretical);
+        }
+
         static void writeLog(Engine            & self,
                              std::string const & filename,
                              bool_t      const & isModeBinary)
@@ -1406,6 +1580,12 @@ namespace python
             self.registerForceProfile(frameName, std::move(forceFct));
         }
 
+        static result_t setDomainRandomization(Engine                                     & self,
+                                               std::shared_ptr<DomainRandomization> const & domainRandomization)
+        {
+            return self.setDomainRandomization(domainRandomization);
+        }
+
         static void removeForces(Engine & self)
         {
             self.reset(true);
@@ -1415,11 +1595,10 @@ namespace python
         /// \brief      Getters and Setters
         ///////////////////////////////////////////////////////////////////////////////
 
-        static bp::tuple formatLog(std::vector<std::string>             const & header,
-                                   std::vector<float64_t>               const & timestamps,
-                                   std::vector<std::vector<int32_t> >         & intData,
-                                   std::vector<std::vector<float32_t> >       & floatData,
-                                   bool_t                               const & clear_memory = true)
+        static bp::tuple formatLog(std::vector<std::string> const & header,
+                                   vectorN_t                const & timestamps,
+                                   intDataMatrix_t          const & intData,
+                                   floatDataMatrix_t        const & floatData)
         {
             bp::dict constants;
             bp::dict data;
@@ -1433,31 +1612,16 @@ namespace python
             }
 
             // Get Global.Time
-            Eigen::Ref<Eigen::Matrix<float64_t, Eigen::Dynamic, 1> const> timeBuffer =
-                Eigen::Matrix<float64_t, Eigen::Dynamic, 1>::Map(
-                    timestamps.data(), timestamps.size());
-            PyObject * valuePyTime(getNumpyReferenceFromEigenVector(timeBuffer));
+            PyObject * valuePyTime(getNumpyReferenceFromEigenVector(timestamps));
             data[header[lastConstantId + 1]] = bp::object(bp::handle<>(PyArray_FROM_OF(valuePyTime, NPY_ARRAY_ENSURECOPY)));
             Py_XDECREF(valuePyTime);
 
-            // Get intergers
-            Eigen::Matrix<int32_t, Eigen::Dynamic, Eigen::Dynamic> intDataMatrix;
-            intDataMatrix.resize(timestamps.size(), intData[0].size());
-            for (uint32_t i=0; i<intData.size(); i++)
-            {
-                intDataMatrix.row(i) = Eigen::Matrix<int32_t, 1, Eigen::Dynamic>::Map(
-                    intData[i].data(), intData[0].size());
-            }
-            if (clear_memory)
-            {
-                intData.clear();
-            }
-
-            for (uint32_t i=0; i<intData[0].size(); i++)
+            // Get integers
+            for (uint32_t i=0; i<intData.cols(); i++)
             {
-                PyObject * valuePyInt(getNumpyReferenceFromEigenVector(intDataMatrix.col(i)));
+                PyObject * valuePyInt(getNumpyReferenceFromEigenVector(intData.col(i)));
                 std::string const & header_i = header[i + (lastConstantId + 1) + 1];
-                // One must make copies with PyArray_FROM_OF instead of using raw pointer for floatDataMatrix
+                // One must make copies with PyArray_FROM_OF instead of using raw pointer for intData
                 // and setting NPY_ARRAY_OWNDATA because otherwise Python is not able to free the memory
                 // associated with each columns independently.
                 // Moreover, one must decrease manually the counter reference for some reason...
@@ -1466,22 +1630,10 @@ namespace python
             }
 
             // Get floats
-            Eigen::Matrix<float32_t, Eigen::Dynamic, Eigen::Dynamic> floatDataMatrix;
-            floatDataMatrix.resize(timestamps.size(), floatData[0].size());
-            for (uint32_t i=0; i<floatData.size(); i++)
-            {
-                floatDataMatrix.row(i) = Eigen::Matrix<float32_t, 1, Eigen::Dynamic>::Map(
-                    floatData[i].data(), floatData[0].size());
-            }
-            if (clear_memory)
+            for (uint32_t i=0; i<floatData.cols(); i++)
             {
-                floatData.clear();
-            }
-
-            for (uint32_t i=0; i<floatData[0].size(); i++)
-            {
-                PyObject * valuePyFloat(getNumpyReferenceFromEigenVector(floatDataMatrix.col(i)));
-                std::string const & header_i = header[i + (lastConstantId + 1) + 1 + intData[0].size()];
+                PyObject * valuePyFloat(getNumpyReferenceFromEigenVector(floatData.col(i)));
+                std::string const & header_i = header[i + (lastConstantId + 1) + 1 + intData.cols()];
                 data[header_i] = bp::object(bp::handle<>(PyArray_FROM_OF(valuePyFloat, NPY_ARRAY_ENSURECOPY)));
                 Py_XDECREF(valuePyFloat);
             }
@@ -1492,20 +1644,20 @@ namespace python
         static bp::tuple getLog(Engine & self)
         {
             std::vector<std::string> header;
-            std::vector<float64_t> timestamps;
-            std::vector<std::vector<int32_t> > intData;
-            std::vector<std::vector<float32_t> > floatData;
-            self.getLogDataRaw(header, timestamps, intData, floatData);
+            vectorN_t timestamps;
+            intDataMatrix_t intData;
+            floatDataMatrix_t floatData;
+            self.getLogDataColumns(header, timestamps, intData, floatData);
             return formatLog(header, timestamps, intData, floatData);
         }
 
         static bp::tuple parseLogBinary(std::string const & filename)
         {
             std::vector<std::string> header;
-            std::vector<float64_t> timestamps;
-            std::vector<std::vector<int32_t> > intData;
-            std::vector<std::vector<float32_t> > floatData;
-            result_t returnCode = Engine::parseLogBinaryRaw(filename, header, timestamps, intData, floatData);
+            vectorN_t timestamps;
+            intDataMatrix_t intData;
+            floatDataMatrix_t floatData;
+            result_t returnCode = Engine::parseLogBinaryColumns(filename, header, timestamps, intData, floatData);
             if (returnCode == result_t::SUCCESS)
             {
                 return formatLog(header, timestamps, intData, floatData);
@@ -1542,6 +1694,514 @@ namespace python
                 .def(PyEngineVisitor());
         }
     };
+
+    // ***************************** PyEngineBatchVisitor ***********************************
+
+    struct PyEngineBatchVisitor
+        : public bp::def_visitor<PyEngineBatchVisitor>
+    {
+    public:
+        using batchMatrix_t = EngineBatch::batchMatrix_t;
+
+    public:
+        ///////////////////////////////////////////////////////////////////////////////
+        /// \brief Expose C++ API through the visitor.
+        ///////////////////////////////////////////////////////////////////////////////
+        template<class PyClass>
+        void visit(PyClass& cl) const
+        {
+            cl
+                .def("initialize", &PyEngineBatchVisitor::initialize,
+                                   (bp::arg("self"), "models",
+                                    bp::arg("num_threads") = 0U))
+                .def("start", &PyEngineBatchVisitor::start,
+                              (bp::arg("self"), "x_init",
+                               bp::arg("is_state_theoretical") = false,
+                               bp::arg("reset_random_generator") = false))
+                .def("step", &PyEngineBatchVisitor::step,
+                             (bp::arg("self"), "u_command",
+                              bp::arg("dt_desired") = -1,
+                              bp::arg("x") = bp::object(),
+                              bp::arg("sensors_data") = bp::object()))
+                .def("step_multiple", &PyEngineBatchVisitor::stepMultiple,
+                                      (bp::arg("self"), "u_command", "num_steps",
+                                       bp::arg("dt_desired") = -1,
+                                       bp::arg("t") = bp::object(),
+                                       bp::arg("x") = bp::object(),
+                                       bp::arg("sensors_data") = bp::object()))
+                .def("stop", &EngineBatch::stop, (bp::arg("self")))
+                .def("set_domain_randomization", &PyEngineBatchVisitor::setDomainRandomization,
+                                                 (bp::arg("self"), "domain_randomization"))
+
+                .def("__len__", &EngineBatch::size)
+                .def("__getitem__", &EngineBatch::getEngine,
+                                    bp::return_internal_reference<>(),
+                                    (bp::arg("self"), "idx"))
+
+                .add_property("nx", bp::make_function(&EngineBatch::nx,
+                                    bp::return_value_policy<bp::copy_const_reference>()))
+                .add_property("nu", bp::make_function(&EngineBatch::nu,
+                                    bp::return_value_policy<bp::copy_const_reference>()))
+                .add_property("sensors_data_size", bp::make_function(&EngineBatch::getSensorsDataSize,
+                                                   bp::return_value_policy<bp::copy_const_reference>()))
+                ;
+        }
+
+        static result_t setDomainRandomization(EngineBatch                                & self,
+                                               std::shared_ptr<DomainRandomization> const & domainRandomization)
+        {
+            return self.setDomainRandomization(domainRandomization);
+        }
+
+        static result_t initialize(EngineBatch        & self,
+                                   bp::list     const & modelsPy,
+                                   uint32_t     const & numThreads)
+        {
+            return self.initialize(listPyToStdVector<std::shared_ptr<Model> >(modelsPy), numThreads);
+        }
+
+        ///////////////////////////////////////////////////////////////////////////////
+        /// \brief      Get a writable view of a C-contiguous numpy array of float64.
+        ///
+        /// \details    None is mapped to an empty view, which is ignored by the engine.
+        ///             The array must have at least 2 dimensions. The trailing ones are
+        ///             flattened, so that an array of shape (N, K, n) is seen as (N, K * n).
+        ///////////////////////////////////////////////////////////////////////////////
+        static result_t getBatchMatrixPy(bp::object                const & dataPy,
+                                         Eigen::Map<batchMatrix_t>       & data)
+        {
+            if (dataPy.is_none())
+            {
+                new (&data) Eigen::Map<batchMatrix_t>(nullptr, 0, 0);
+                return result_t::SUCCESS;
+            }
+
+            PyArrayObject * dataPyArray = reinterpret_cast<PyArrayObject *>(dataPy.ptr());
+            if (!PyArray_Check(dataPy.ptr())
+             || PyArray_NDIM(dataPyArray) < 2
+             || PyArray_TYPE(dataPyArray) != NPY_FLOAT64
+             || !PyArray_IS_C_CONTIGUOUS(dataPyArray)
+             || !PyArray_ISWRITEABLE(dataPyArray))
+            {
+                std::cout << "Error - PyEngineBatchVisitor::getBatchMatrixPy - The buffers must be writable C-contiguous arrays of float64 with at least 2 dimensions." << std::endl;
+                return result_t::ERROR_BAD_INPUT;
+            }
+
+            npy_intp const rows = PyArray_DIM(dataPyArray, 0);
+            new (&data) Eigen::Map<batchMatrix_t>(static_cast<float64_t *>(PyArray_DATA(dataPyArray)),
+                                                  rows, (rows > 0) ? PyArray_SIZE(dataPyArray) / rows : 0);
+            return result_t::SUCCESS;
+        }
+
+        static result_t start(EngineBatch       & self,
+                              matrixN_t   const & xInit,
+                              bool_t      const & isStateTheoretical,
+                              bool_t      const & resetRandomNumbers)
+        {
+            // Eigenpy only provides converters for column-major matrices
+
+            ScopedGILRelease gilRelease;
+            return self.start(xInit, isStateTheoretical, resetRandomNumbers);
+        }
+
+        ///////////////////////////////////////////////////////////////////////////////
+        /// \brief      Step every engine of the batch, without holding the GIL.
+        ///
+        /// \details    The states and the sensors data are written in place in the
+        ///             preallocated buffers 'x' and 'sensors_data', of respective shape
+        ///             (N, nx) and (N, sensors_data_size), if provided.
+        ///////////////////////////////////////////////////////////////////////////////
+        static result_t step(EngineBatch       & self,
+                             bp::object  const & uCommandPy,
+                             float64_t   const & dtDesired,
+                             bp::object  const & xPy,
+                             bp::object  const & sensorsDataPy)
+        {
+            return stepMultiple(self, uCommandPy, 1U, dtDesired, bp::object(), xPy, sensorsDataPy);
+        }
+
+        ///////////////////////////////////////////////////////////////////////////////
+        /// \brief      Perform several consecutive steps of every engine of the batch,
+        ///             without holding the GIL.
+        ///
+        /// \details    The commands are either of shape (N, nu), in which case they are
+        ///             held for every step, or of shape (N, num_steps, nu). The timestamps,
+        ///             the states and the sensors data at the end of every step are written
+        ///             in place in the preallocated buffers 't', 'x' and 'sensors_data', of
+        ///             respective shape (N, num_steps), (N, num_steps, nx) and
+        ///             (N, num_steps, sensors_data_size), if provided.
+        ///////////////////////////////////////////////////////////////////////////////
+        static result_t stepMultiple(EngineBatch       & self,
+                                     bp::object  const & uCommandPy,
+                                     uint32_t    const & numSteps,
+                                     float64_t   const & dtDesired,
+                                     bp::object  const & tPy,
+                                     bp::object  const & xPy,
+                                     bp::object  const & sensorsDataPy)
+        {
+            // The commands are only converted if they are not already a C-contiguous array of float64
+            PyObject * uCommandPyArray = PyArray_FROM_OTF(uCommandPy.ptr(), NPY_FLOAT64, NPY_ARRAY_IN_ARRAY);
+            if (uCommandPyArray == nullptr || PyArray_NDIM(reinterpret_cast<PyArrayObject *>(uCommandPyArray)) < 2)
+            {
+                PyErr_Clear();
+                Py_XDECREF(uCommandPyArray);
+                std::cout << "Error - PyEngineBatchVisitor::stepMultiple - The commands must be an array with at least 2 dimensions." << std::endl;
+                return result_t::ERROR_BAD_INPUT;
+            }
+            bp::object uCommandPyHolder{bp::handle<>(uCommandPyArray)};
+            npy_intp const uCommandRows = PyArray_DIM(reinterpret_cast<PyArrayObject *>(uCommandPyArray), 0);
+            Eigen::Map<batchMatrix_t const> uCommand(
+                static_cast<float64_t *>(PyArray_DATA(reinterpret_cast<PyArrayObject *>(uCommandPyArray))),
+                uCommandRows,
+                (uCommandRows > 0) ? PyArray_SIZE(reinterpret_cast<PyArrayObject *>(uCommandPyArray)) / uCommandRows : 0);
+
+            Eigen::Map<batchMatrix_t> t(nullptr, 0, 0);
+            Eigen::Map<batchMatrix_t> x(nullptr, 0, 0);
+            Eigen::Map<batchMatrix_t> sensorsData(nullptr, 0, 0);
+            result_t returnCode = getBatchMatrixPy(tPy, t);
+            if (returnCode == result_t::SUCCESS)
+            {
+                returnCode = getBatchMatrixPy(xPy, x);
+            }
+            if (returnCode == result_t::SUCCESS)
+            {
+                returnCode = getBatchMatrixPy(sensorsDataPy, sensorsData);
+            }
+
+            if (returnCode == result_t::SUCCESS)
+            {
+                ScopedGILRelease gilRelease;
+                returnCode = self.stepMultiple(uCommand, numSteps, dtDesired, t, x, sensorsData);
+            }
+
+            return returnCode;
+        }
+
+        ///////////////////////////////////////////////////////////////////////////////
+        /// \brief Expose.
+        ///////////////////////////////////////////////////////////////////////////////
+        static void expose()
+        {
+            bp::class_<EngineBatch,
+                       boost::shared_ptr<EngineBatch>,
+                       boost::noncopyable>("EngineBatch")
+                .def(PyEngineBatchVisitor());
+        }
+    };
+
+    // ***************************** PyEnvironmentVisitor ***********************************
+
+    struct PyEnvironmentVisitor
+        : public bp::def_visitor<PyEnvironmentVisitor>
+    {
+    public:
+        ///////////////////////////////////////////////////////////////////////////////
+        /// \brief Expose C++ API through the visitor.
+        ///////////////////////////////////////////////////////////////////////////////
+        template<class PyClass>
+        void visit(PyClass& cl) const
+        {
+            cl
+                .def("initialize", &Environment::initialize,
+                                   (bp::arg("self"), "engine"))
+                .def("add_observation_state", &Environment::addObservationState,
+                                              (bp::arg("self"), "start_idx", "size"))
+                .def("add_observation_sensors", &Environment::addObservationSensors,
+                                                (bp::arg("self"), "sensor_type"))
+                .def("add_reward_term", &Environment::addRewardTerm,
+                                        (bp::arg("self"), "reward_term",
+                                         bp::arg("weight") = 1.0))
+                .def("add_termination_condition", &Environment::addTerminationCondition,
+                                                  (bp::arg("self"), "condition"))
+                .def("clear", &Environment::clear)
+                .def("reset", &Environment::reset)
+                .def("compute", &PyEnvironmentVisitor::compute)
+
+                .add_property("observation", &PyEnvironmentVisitor::getObservation)
+                .add_property("observation_size", bp::make_function(&Environment::getObservationSize,
+                                                  bp::return_value_policy<bp::copy_const_reference>()))
+                .add_property("is_initialized", bp::make_function(&Environment::getIsInitialized,
+                                                bp::return_value_policy<bp::copy_const_reference>()))
+                .add_property("engine", bp::make_function(&Environment::getEngine,
+                                        bp::return_internal_reference<>()))
+                ;
+        }
+
+        ///////////////////////////////////////////////////////////////////////////////
+        /// \brief      Compute the reward and the termination flag, and update the observation.
+        ///
+        /// \return     Tuple (reward, is_done).
+        ///////////////////////////////////////////////////////////////////////////////
+        static bp::object compute(Environment & self)
+        {
+            float64_t reward;
+            bool_t isDone;
+            if (self.compute(reward, isDone) != result_t::SUCCESS)
+            {
+                PyErr_SetString(PyExc_RuntimeError, "The environment must be reset first.");
+                bp::throw_error_already_set();
+            }
+            return bp::make_tuple(reward, isDone);
+        }
+
+        ///////////////////////////////////////////////////////////////////////////////
+        /// \brief      Get the observation.
+        ///
+        /// \details    It is a read-only view on the internal buffer, which is updated in
+        ///             place by compute, and reallocated by reset.
+        ///////////////////////////////////////////////////////////////////////////////
+        static bp::object getObservation(bp::object const & selfPy)
+        {
+            Environment & self = bp::extract<Environment &>(selfPy);
+            vectorN_t const & observation = self.getObservation();
+            return bp::object(bp::handle<>(makeNumpyReadOnly(
+                getNumpyReferenceFromEigenVector(observation), selfPy.ptr())));
+        }
+
+        static boost::shared_ptr<TrackingReward> TrackingRewardPyFactory(uint32_t  const & startIdx,
+                                                                         vectorN_t const & target)
+        {
+            return boost::make_shared<TrackingReward>(startIdx, target);
+        }
+
+        static boost::shared_ptr<StateBoundsCondition> StateBoundsConditionPyFactory(uint32_t  const & startIdx,
+                                                                                     vectorN_t const & lowerBound,
+                                                                                     vectorN_t const & upperBound)
+        {
+            return boost::make_shared<StateBoundsCondition>(startIdx, lowerBound, upperBound);
+        }
+
+        template<typename TCondition>
+        static boost::shared_ptr<TCondition> FrameConditionPyFactory(std::string const & frameName,
+                                                                     float64_t   const & threshold)
+        {
+            return boost::make_shared<TCondition>(frameName, threshold);
+        }
+
+        static boost::shared_ptr<WallClockCondition> WallClockConditionPyFactory(float64_t const & durationMax)
+        {
+            return boost::make_shared<WallClockCondition>(durationMax);
+        }
+
+        ///////////////////////////////////////////////////////////////////////////////
+        /// \brief Expose.
+        ///////////////////////////////////////////////////////////////////////////////
+        static void expose()
+        {
+            bp::class_<AbstractRewardTerm,
+                       boost::shared_ptr<AbstractRewardTerm>,
+                       boost::noncopyable>("AbstractRewardTerm", bp::no_init);
+            bp::register_ptr_to_python<std::shared_ptr<AbstractRewardTerm> >();
+
+            bp::class_<TrackingReward, bp::bases<AbstractRewardTerm>,
+                       boost::shared_ptr<TrackingReward>,
+                       boost::noncopyable>("TrackingReward", bp::no_init)
+                .def("__init__", bp::make_constructor(&PyEnvironmentVisitor::TrackingRewardPyFactory,
+                                 bp::default_call_policies(),
+                                 (bp::arg("start_idx"), "target")))
+                .def("set_target", &TrackingReward::setTarget,
+                                   (bp::arg("self"), "target"));
+            bp::class_<TorqueReward, bp::bases<AbstractRewardTerm>,
+                       boost::shared_ptr<TorqueReward>,
+                       boost::noncopyable>("TorqueReward");
+            bp::class_<EnergyReward, bp::bases<AbstractRewardTerm>,
+                       boost::shared_ptr<EnergyReward>,
+                       boost::noncopyable>("EnergyReward");
+            bp::class_<SurvivalReward, bp::bases<AbstractRewardTerm>,
+                       boost::shared_ptr<SurvivalReward>,
+                       boost::noncopyable>("SurvivalReward");
+
+            bp::class_<AbstractTerminationCondition,
+                       boost::shared_ptr<AbstractTerminationCondition>,
+                       boost::noncopyable>("AbstractTerminationCondition", bp::no_init);
+            bp::register_ptr_to_python<std::shared_ptr<AbstractTerminationCondition> >();
+
+            bp::class_<StateBoundsCondition, bp::bases<AbstractTerminationCondition>,
+                       boost::shared_ptr<StateBoundsCondition>,
+                       boost::noncopyable>("StateBoundsCondition", bp::no_init)
+                .def("__init__", bp::make_constructor(&PyEnvironmentVisitor::StateBoundsConditionPyFactory,
+                                 bp::default_call_policies(),
+                                 (bp::arg("start_idx"), "lower_bound", "upper_bound")));
+            bp::class_<NanCondition, bp::bases<AbstractTerminationCondition>,
+                       boost::shared_ptr<NanCondition>,
+                       boost::noncopyable>("NanCondition");
+            bp::class_<FrameHeightCondition, bp::bases<AbstractTerminationCondition>,
+                       boost::shared_ptr<FrameHeightCondition>,
+                       boost::noncopyable>("FrameHeightCondition", bp::no_init)
+                .def("__init__", bp::make_constructor(&PyEnvironmentVisitor::FrameConditionPyFactory<FrameHeightCondition>,
+                                 bp::default_call_policies(),
+                                 (bp::arg("frame_name"), "height_min")));
+            bp::class_<FrameOrientationCondition, bp::bases<AbstractTerminationCondition>,
+                       boost::shared_ptr<FrameOrientationCondition>,
+                       boost::noncopyable>("FrameOrientationCondition", bp::no_init)
+                .def("__init__", bp::make_constructor(&PyEnvironmentVisitor::FrameConditionPyFactory<FrameOrientationCondition>,
+                                 bp::default_call_policies(),
+                                 (bp::arg("frame_name"), "angle_max")));
+            bp::class_<WallClockCondition, bp::bases<AbstractTerminationCondition>,
+                       boost::shared_ptr<WallClockCondition>,
+                       boost::noncopyable>("WallClockCondition", bp::no_init)
+                .def("__init__", bp::make_constructor(&PyEnvironmentVisitor::WallClockConditionPyFactory,
+                                 bp::default_call_policies(),
+                                 (bp::arg("duration_max"))));
+
+            bp::enum_<randomizedParameter_t>("randomizedParameter_t")
+            .value("CONTACT_FRICTION_VISCOUS", randomizedParameter_t::CONTACT_FRICTION_VISCOUS)
+            .value("CONTACT_FRICTION_DRY", randomizedParameter_t::CONTACT_FRICTION_DRY)
+            .value("CONTACT_STIFFNESS", randomizedParameter_t::CONTACT_STIFFNESS)
+            .value("CONTACT_DAMPING", randomizedParameter_t::CONTACT_DAMPING)
+            .value("MOTORS_TORQUE_LIMIT", randomizedParameter_t::MOTORS_TORQUE_LIMIT)
+            .value("MOTORS_ROTOR_INERTIA", randomizedParameter_t::MOTORS_ROTOR_INERTIA);
+
+            bp::class_<DomainRandomization,
+                       boost::shared_ptr<DomainRandomization>,
+                       boost::noncopyable>("DomainRandomization")
+                .def("add_parameter", &DomainRandomization::addParameter,
+                                      (bp::arg("self"), "parameter", "scale_min", "scale_max"))
+                .def("clear", &DomainRandomization::clear)
+                .add_property("num_parameters", &DomainRandomization::getNumParameters);
+            bp::register_ptr_to_python<std::shared_ptr<DomainRandomization> >();
+
+            bp::class_<Environment,
+                       boost::shared_ptr<Environment>,
+                       boost::noncopyable>("Environment")
+                .def(PyEnvironmentVisitor());
+        }
+    };
+
+    // ***************************** PyTelemetryDatasetVisitor ***********************************
+
+    struct PyTelemetryDatasetVisitor
+        : public bp::def_visitor<PyTelemetryDatasetVisitor>
+    {
+    public:
+        ///////////////////////////////////////////////////////////////////////////////
+        /// \brief Expose C++ API through the visitor.
+        ///////////////////////////////////////////////////////////////////////////////
+        template<class PyClass>
+        void visit(PyClass& cl) const
+        {
+            cl
+                .def("open", &PyTelemetryDatasetVisitor::open,
+                             (bp::arg("self"), "filename",
+                              bp::arg("read_only") = true,
+                              bp::arg("truncate") = false))
+                .def("close", &TelemetryDataset::close)
+                .def("flush", &TelemetryDataset::flush)
+                .def("append_episode", &PyTelemetryDatasetVisitor::appendEpisode,
+                                       (bp::arg("self"), "engine"))
+                .def("get_episode_length", &TelemetryDataset::getEpisodeLength,
+                                           (bp::arg("self"), "episode_idx"))
+                .def("get_episode", &PyTelemetryDatasetVisitor::getEpisode,
+                                    (bp::arg("self"), "episode_idx"))
+
+                .add_property("num_episodes", &TelemetryDataset::getNumEpisodes)
+                .add_property("header", bp::make_function(&TelemetryDataset::getHeader,
+                                        bp::return_value_policy<bp::copy_const_reference>()))
+                ;
+        }
+
+        static result_t open(TelemetryDataset       & self,
+                             std::string      const & filename,
+                             bool_t           const & readOnly,
+                             bool_t           const & truncate)
+        {
+            enum OpenMode mode = readOnly ? OpenMode::READ_ONLY : OpenMode::READ_WRITE;
+            if (truncate)
+            {
+                mode |= OpenMode::TRUNCATE;
+            }
+            return self.open(filename, mode);
+        }
+
+        static result_t appendEpisode(TelemetryDataset & self,
+                                      Engine           & engine)
+        {
+            return engine.writeLogDataset(self);
+        }
+
+        static void releaseMapping(PyObject * mappingPy)
+        {
+            delete static_cast<std::shared_ptr<char_t const> *>(PyCapsule_GetPointer(mappingPy, NULL));
+        }
+
+        template<typename T>
+        static PyObject * getColumnPy(datasetColumn_t<T> const & column,
+                                      PyObject                 * basePy)
+        {
+            // Read-only view on the memory mapped file, which keeps the mapping alive
+            npy_intp dims[1] = {npy_intp(column.size())};
+            npy_intp strides[1] = {npy_intp(column.innerStride() * sizeof(T))};
+            PyObject * columnPy = PyArray_New(&PyArray_Type, 1, dims, getPyType(*column.data()), strides,
+                                              const_cast<T *>(column.data()), 0, NPY_ARRAY_ALIGNED, NULL);
+            Py_INCREF(basePy);
+            PyArray_SetBaseObject(reinterpret_cast<PyArrayObject *>(columnPy), basePy);
+            return columnPy;
+        }
+
+        ///////////////////////////////////////////////////////////////////////////////
+        /// \brief     Get an episode of the dataset, in the same format as Engine.get_log.
+        ///
+        /// \details   Apart from Global.Time, the columns are read-only views on the memory
+        ///            mapped file. They own a share of the mapping, so that they remain valid
+        ///            even after the dataset is closed.
+        ///////////////////////////////////////////////////////////////////////////////
+        static bp::tuple getEpisode(TelemetryDataset       & self,
+                                    int64_t          const & episodeIdx)
+        {
+            std::vector<std::string> const & header = self.getHeader();
+
+            bp::dict constants;
+            bp::dict data;
+
+            if (episodeIdx < 0 || episodeIdx >= self.getNumEpisodes() || !self.getMapping())
+            {
+                return bp::make_tuple(data, constants);
+            }
+
+            // Get constants
+            uint32_t lastConstantId = std::distance(header.begin(), std::find(header.begin(), header.end(), START_COLUMNS));
+            for (uint32_t i = 1; i < lastConstantId; i++)
+            {
+                int32_t delimiter = header[i].find("=");
+                constants[header[i].substr(0, delimiter)] = header[i].substr(delimiter + 1);
+            }
+
+            // Get Global.Time, which must be converted in seconds
+            vectorN_t timestamps = self.getIntColumn(episodeIdx, 0).cast<float64_t>() * 1.0e-6;
+            PyObject * valuePyTime(getNumpyReferenceFromEigenVector(timestamps));
+            data[header[lastConstantId + 1]] = bp::object(bp::handle<>(PyArray_FROM_OF(valuePyTime, NPY_ARRAY_ENSURECOPY)));
+            Py_XDECREF(valuePyTime);
+
+            // Get integers and floats, sharing the ownership of the mapping
+            bp::object mappingPy(bp::handle<>(PyCapsule_New(new std::shared_ptr<char_t const>(self.getMapping()),
+                                                            NULL, &PyTelemetryDatasetVisitor::releaseMapping)));
+            int32_t const numIntEntries = self.getNumIntEntries();
+            int32_t const numFloatEntries = self.getNumFloatEntries();
+            for (int32_t i = 1; i < numIntEntries; i++)
+            {
+                std::string const & header_i = header[i + (lastConstantId + 1)];
+                data[header_i] = bp::object(bp::handle<>(getColumnPy(self.getIntColumn(episodeIdx, i), mappingPy.ptr())));
+            }
+            for (int32_t i = numIntEntries; i < numIntEntries + numFloatEntries; i++)
+            {
+                std::string const & header_i = header[i + (lastConstantId + 1)];
+                data[header_i] = bp::object(bp::handle<>(getColumnPy(self.getFloatColumn(episodeIdx, i), mappingPy.ptr())));
+            }
+
+            return bp::make_tuple(data, constants);
+        }
+
+        ///////////////////////////////////////////////////////////////////////////////
+        /// \brief Expose.
+        ///////////////////////////////////////////////////////////////////////////////
+        static void expose()
+        {
+            bp::class_<TelemetryDataset,
+                       boost::shared_ptr<TelemetryDataset>,
+                       boost::noncopyable>("TelemetryDataset")
+                .def(PyTelemetryDatasetVisitor());
+        }
+    };
 }  // End of namespace python.
 }  // End of namespace jiminy.
 
@@ -24,6 +24,64 @@ namespace python
         matrixRow
     };
 
+    ///////////////////////////////////////////////////////////////////////////////
+    /// \brief  Release the GIL for the lifetime of the object.
+    ///
+    /// \details It is used to run native computations without preventing other Python
+    ///          threads from running. The GIL must be acquired back using ScopedGILAcquire
+    ///          before doing anything involving the Python C API.
+    ///////////////////////////////////////////////////////////////////////////////
+    class ScopedGILRelease
+    {
+    public:
+        // Disable the copy of the class
+        ScopedGILRelease(ScopedGILRelease const &) = delete;
+        ScopedGILRelease & operator = (ScopedGILRelease const &) = delete;
+
+    public:
+        ScopedGILRelease(void) :
+        threadState_(PyEval_SaveThread())
+        {
+            // Empty.
+        }
+
+        ~ScopedGILRelease(void)
+        {
+            PyEval_RestoreThread(threadState_);
+        }
+
+    private:
+        PyThreadState * threadState_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////
+    /// \brief  Acquire the GIL for the lifetime of the object.
+    ///
+    /// \details It is safe to use it even if the GIL is already held by the current thread.
+    ///////////////////////////////////////////////////////////////////////////////
+    class ScopedGILAcquire
+    {
+    public:
+        // Disable the copy of the class
+        ScopedGILAcquire(ScopedGILAcquire const &) = delete;
+        ScopedGILAcquire & operator = (ScopedGILAcquire const &) = delete;
+
+    public:
+        ScopedGILAcquire(void) :
+        gilState_(PyGILState_Ensure())
+        {
+            // Empty.
+        }
+
+        ~ScopedGILAcquire(void)
+        {
+            PyGILState_Release(gilState_);
+        }
+
+    private:
+        PyGILState_STATE gilState_;
+    };
+
     inline int getPyType(bool_t const & data)
     {
         return NPY_BOOL;
@@ -130,9 +188,30 @@ namespace python
     ///////////////////////////////////////////////////////////////////////////////
     PyObject * getNumpyReferenceFromEigenMatrix(Eigen::Ref<matrixN_t const> data)
     {
-        npy_intp dims[2] = {npy_intp(data.cols()), npy_intp(data.rows())};
-        return  PyArray_Transpose(reinterpret_cast<PyArrayObject *>(
-            PyArray_SimpleNewFromData(2, dims, NPY_FLOAT64, const_cast<float64_t *>(data.data()))), NULL);
+        // Column-major array, so that no intermediary transposed array is required
+        npy_intp dims[2] = {npy_intp(data.rows()), npy_intp(data.cols())};
+        npy_intp strides[2] = {npy_intp(sizeof(float64_t)), npy_intp(data.outerStride() * sizeof(float64_t))};
+        return PyArray_New(&PyArray_Type, 2, dims, NPY_FLOAT64, strides,
+                           const_cast<float64_t *>(data.data()), 0, NPY_ARRAY_FARRAY, NULL);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    /// \brief  Prevent the original data to be altered through a Numpy array by reference.
+    ///
+    /// \details Optionally, the lifetime of the array can be bound to the one of a
+    ///          Python object, typically the one owning the original data.
+    ///////////////////////////////////////////////////////////////////////////////
+    PyObject * makeNumpyReadOnly(PyObject * dataPy,
+                                 PyObject * basePy = nullptr)
+    {
+        PyArrayObject * dataPyArray = reinterpret_cast<PyArrayObject *>(dataPy);
+        PyArray_CLEARFLAGS(dataPyArray, NPY_ARRAY_WRITEABLE);
+        if (basePy)
+        {
+            Py_INCREF(basePy);
+            PyArray_SetBaseObject(dataPyArray, basePy);
+        }
+        return dataPy;
     }
 
 
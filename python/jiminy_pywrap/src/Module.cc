@@ -31,6 +31,10 @@ namespace python
     {
         // Required to initialized Python C API
         Py_Initialize();
+        #if PY_VERSION_HEX < 0x03070000
+        // Required to release the GIL in native code and acquire it back in callbacks
+        PyEval_InitThreads();
+        #endif
         // Required to handle numpy::ndarray object (it loads Python C API of Numpy) and ufunc
         bp::numpy::initialize();
         // Required and create PyArrays<->Eigen automatic converters.
@@ -66,6 +70,9 @@ namespace python
         jiminy::python::HeatMapFunctorVisitor::expose();
         jiminy::python::PyStepperVisitor::expose();
         jiminy::python::PyEngineVisitor::expose();
+        jiminy::python::PyEngineBatchVisitor::expose();
+        jiminy::python::PyEnvironmentVisitor::expose();
+        jiminy::python::PyTelemetryDatasetVisitor::expose();
     }
 }
 }
@@ -0,0 +1,79 @@
+// Helpers shared by the unit tests, building a simulation of a double pendulum
+// whose joints are both actuated, driven by a controller sending zero torque.
+#ifndef JIMINY_UNIT_DOUBLE_PENDULUM_H
+#define JIMINY_UNIT_DOUBLE_PENDULUM_H
+
+#include <pinocchio/fwd.hpp>
+#include <string>
+#include <vector>
+
+#include "jiminy/core/Engine.h"
+#include "jiminy/core/BasicMotors.h"
+#include "jiminy/core/ControllerFunctor.h"
+#include "jiminy/core/Utilities.h"
+#include "jiminy/core/Types.h"
+
+
+namespace jiminy
+{
+namespace unit
+{
+    std::string const DOUBLE_PENDULUM_URDF("data/double_pendulum_rigid.urdf");
+    std::vector<std::string> const DOUBLE_PENDULUM_JOINTS{"PendulumJoint", "SecondPendulumJoint"};
+
+    inline void zeroTorque(float64_t        const & t,
+                           vectorN_t        const & q,
+                           vectorN_t        const & v,
+                           sensorsDataMap_t const & sensorData,
+                           vectorN_t              & u)
+    {
+        u.setZero();
+    }
+
+    inline bool_t alwaysContinue(float64_t const & t,
+                                 vectorN_t const & x)
+    {
+        return true;
+    }
+
+    inline std::shared_ptr<Model> buildDoublePendulumModel(void)
+    {
+        auto model = std::make_shared<Model>();
+        model->initialize(DOUBLE_PENDULUM_URDF, false);
+        for (std::string const & jointName : DOUBLE_PENDULUM_JOINTS)
+        {
+            auto motor = std::make_shared<SimpleMotor>(jointName);
+            model->attachMotor(motor);
+            motor->initialize(jointName);
+        }
+        return model;
+    }
+
+    inline std::shared_ptr<Engine> buildDoublePendulumEngine(std::shared_ptr<Model> const & model)
+    {
+        auto controller = std::make_shared<ControllerFunctor<decltype(zeroTorque),
+                                                             decltype(zeroTorque)> >(zeroTorque, zeroTorque);
+        controller->initialize(model);
+
+        auto engine = std::make_shared<Engine>();
+        engine->initialize(model, controller, alwaysContinue);
+        return engine;
+    }
+
+    inline std::shared_ptr<Engine> buildDoublePendulumEngine(void)
+    {
+        return buildDoublePendulumEngine(buildDoublePendulumModel());
+    }
+
+    inline void setStepperOption(Engine              & engine,
+                                 std::string   const & name,
+                                 configField_t const & value)
+    {
+        configHolder_t engineOptions = engine.getOptions();
+        boost::get<configHolder_t>(engineOptions.at("stepper")).at(name) = value;
+        engine.setOptions(engineOptions);
+    }
+}
+}
+
+#endif // JIMINY_UNIT_DOUBLE_PENDULUM_H
@@ -0,0 +1,130 @@
+// Test that the simulations of a batch of engines are reproducible, whatever the
+// number of worker threads, and that every engine draws its own random numbers,
+// including the randomized parameters.
+#include <gtest/gtest.h>
+
+#include "jiminy/core/BasicSensors.h"
+#include "jiminy/core/DomainRandomization.h"
+#include "jiminy/core/EngineBatch.h"
+
+#include "DoublePendulum.h"
+
+using namespace jiminy;
+
+namespace
+{
+    uint32_t const NUM_ENGINES = 4U;
+    uint32_t const NUM_STEPS = 50U;
+    float64_t const STEP_SIZE = 1.0e-2;
+
+    // Simulate a batch of noisy double pendulums, and return the sensors data of every step
+    EngineBatch::batchMatrix_t simulateBatch(uint32_t const & numThreads)
+    {
+        std::vector<std::shared_ptr<Model> > models;
+        for (uint32_t i = 0; i < NUM_ENGINES; i++)
+        {
+            std::shared_ptr<Model> model = unit::buildDoublePendulumModel();
+            for (std::string const & jointName : unit::DOUBLE_PENDULUM_JOINTS)
+            {
+                auto sensor = std::make_shared<EncoderSensor>(jointName);
+                model->attachSensor(sensor);
+                sensor->initialize(jointName);
+                configHolder_t sensorOptions = sensor->getOptions();
+                sensorOptions.at("noiseStd") = vectorN_t::Constant(2, 0.1);
+                sensor->setOptions(sensorOptions);
+            }
+            models.push_back(model);
+        }
+
+        EngineBatch batch;
+        EXPECT_EQ(batch.initialize(models, numThreads), result_t::SUCCESS);
+
+        EngineBatch::batchMatrix_t xInit = EngineBatch::batchMatrix_t::Zero(NUM_ENGINES, batch.nx());
+        xInit.col(0).setConstant(0.5);
+        EXPECT_EQ(batch.start(xInit), result_t::SUCCESS);
+
+        EngineBatch::batchMatrix_t const uCommand = EngineBatch::batchMatrix_t::Zero(NUM_ENGINES, batch.nu());
+        EngineBatch::batchMatrix_t t(NUM_ENGINES, NUM_STEPS);
+        EngineBatch::batchMatrix_t x(NUM_ENGINES, NUM_STEPS * batch.nx());
+        EngineBatch::batchMatrix_t sensorsData(NUM_ENGINES, NUM_STEPS * batch.getSensorsDataSize());
+        EXPECT_EQ(batch.stepMultiple(uCommand, NUM_STEPS, STEP_SIZE, t, x, sensorsData), result_t::SUCCESS);
+        batch.stop();
+
+        return sensorsData;
+    }
+
+    // Torque limits of the motors of an engine, after randomization
+    vectorN_t getTorqueLimits(Engine const & engine)
+    {
+        Model::motorsHolder_t const & motors = engine.getModel().getMotors();
+        vectorN_t torqueLimits(motors.size());
+        for (uint32_t i = 0; i < motors.size(); i++)
+        {
+            torqueLimits[i] = motors[i]->getTorqueLimit();
+        }
+        return torqueLimits;
+    }
+}
+
+
+TEST(EngineBatch, SeededReproducibility)
+{
+    EngineBatch::batchMatrix_t const sensorsDataRef = simulateBatch(1U);
+    ASSERT_GT(sensorsDataRef.cols(), 0);
+
+    // The engines start from the same state, so they only differ because of the noise
+    for (uint32_t i = 1; i < NUM_ENGINES; i++)
+    {
+        EXPECT_FALSE(sensorsDataRef.row(i).isApprox(sensorsDataRef.row(0)));
+    }
+
+    for (uint32_t numThreads : {2U, NUM_ENGINES})
+    {
+        EngineBatch::batchMatrix_t const sensorsData = simulateBatch(numThreads);
+        EXPECT_TRUE(sensorsData == sensorsDataRef);
+    }
+}
+
+TEST(EngineBatch, DomainRandomizationMatchesStandalone)
+{
+    auto domainRandomization = std::make_shared<DomainRandomization>();
+    domainRandomization->addParameter(randomizedParameter_t::MOTORS_TORQUE_LIMIT, 0.5, 1.5);
+
+    std::vector<std::shared_ptr<Model> > models;
+    for (uint32_t i = 0; i < NUM_ENGINES; i++)
+    {
+        models.push_back(unit::buildDoublePendulumModel());
+    }
+    EngineBatch batch;
+    ASSERT_EQ(batch.initialize(models, NUM_ENGINES), result_t::SUCCESS);
+    ASSERT_EQ(batch.setDomainRandomization(domainRandomization), result_t::SUCCESS);
+    EngineBatch::batchMatrix_t const xInit = EngineBatch::batchMatrix_t::Zero(NUM_ENGINES, batch.nx());
+
+    // The same engines, started one by one
+    std::vector<std::shared_ptr<Engine> > engines;
+    for (uint32_t i = 0; i < NUM_ENGINES; i++)
+    {
+        std::shared_ptr<Engine> engine = unit::buildDoublePendulumEngine();
+        ASSERT_EQ(engine->setRandomStreamIdx(i), result_t::SUCCESS);
+        ASSERT_EQ(engine->setDomainRandomization(domainRandomization), result_t::SUCCESS);
+        engines.push_back(engine);
+    }
+
+    // The parameters are sampled again for every episode, whether the generators are reset or not
+    for (bool_t const & resetRandomNumbers : {false, false, true})
+    {
+        ASSERT_EQ(batch.start(xInit, false, resetRandomNumbers), result_t::SUCCESS);
+        for (uint32_t i = 0; i < NUM_ENGINES; i++)
+        {
+            ASSERT_EQ(engines[i]->start(xInit.row(i).transpose(), false, resetRandomNumbers), result_t::SUCCESS);
+            vectorN_t const torqueLimits = getTorqueLimits(batch.getEngine(i));
+            EXPECT_TRUE(getTorqueLimits(*engines[i]) == torqueLimits);
+            if (i > 0)
+            {
+                EXPECT_FALSE(torqueLimits.isApprox(getTorqueLimits(batch.getEngine(0))));
+            }
+            engines[i]->stop();
+        }
+        batch.stop();
+    }
+}
@@ -0,0 +1,84 @@
+// Test the impulse forces, which may overlap or start at the same time: the stepper
+// must stop at every beginning and end, and the forces active at once are summed.
+#include <gtest/gtest.h>
+
+#include "jiminy/core/TelemetryData.h"
+
+#include "DoublePendulum.h"
+
+using namespace jiminy;
+
+namespace
+{
+    std::string const FRAME_NAME("SecondPendulumMass");
+    float64_t const DURATION = 0.6;
+
+    struct impulse_t
+    {
+        float64_t t;
+        float64_t dt;
+        vector3_t F;
+    };
+
+    // Simulate the double pendulum subject to impulse forces, and return the time of every stepper step
+    vectorN_t simulateImpulses(std::vector<impulse_t> const & impulses,
+                               vectorN_t                    & xEnd)
+    {
+        std::shared_ptr<Engine> engine = unit::buildDoublePendulumEngine();
+        unit::setStepperOption(*engine, "dtMax", 1.0e-2);
+        unit::setStepperOption(*engine, "logInternalStepperSteps", true);
+        for (impulse_t const & impulse : impulses)
+        {
+            engine->registerForceImpulse(FRAME_NAME, impulse.t, impulse.dt, impulse.F);
+        }
+
+        vectorN_t x0 = vectorN_t::Zero(4);
+        x0[0] = 0.5;
+        EXPECT_EQ(engine->simulate(DURATION, x0), result_t::SUCCESS);
+        xEnd = engine->getStepperState().x;
+
+        std::vector<std::string> header;
+        matrixN_t logData;
+        engine->getLogData(header, logData);
+        return Engine::getLogFieldValue(GLOBAL_TIME, header, logData);
+    }
+}
+
+
+TEST(ForceImpulse, OverlappingImpulses)
+{
+    vector3_t const F1(10.0, 0.0, 0.0);
+    vector3_t const F2(0.0, 0.0, -20.0);
+    vector3_t const F3(-5.0, 0.0, 5.0);
+
+    /* The first two impulses start at the same time, and the third one starts while
+       the first one is still active. They are not registered in chronological order. */
+    std::vector<impulse_t> const impulses{{0.2345, 0.3, F3},
+                                          {0.1234, 0.2, F1},
+                                          {0.1234, 0.05, F2}};
+    vectorN_t xEnd;
+    vectorN_t const time = simulateImpulses(impulses, xEnd);
+
+    // The stepper stops exactly at every beginning and end of the impulses
+    for (impulse_t const & impulse : impulses)
+    {
+        for (float64_t const & tBreakpoint : {impulse.t, impulse.t + impulse.dt})
+        {
+            EXPECT_LT((time.array() - tBreakpoint).abs().minCoeff(), 1.0e-9) << "Breakpoint " << tBreakpoint;
+        }
+    }
+
+    // Same forces, as a sequence of impulses that do not overlap
+    std::vector<impulse_t> const impulsesSequence{{0.1234, 0.05, F1 + F2},
+                                                  {0.1234 + 0.05, 0.2345 - (0.1234 + 0.05), F1},
+                                                  {0.2345, (0.1234 + 0.2) - 0.2345, F1 + F3},
+                                                  {0.1234 + 0.2, (0.2345 + 0.3) - (0.1234 + 0.2), F3}};
+    vectorN_t xEndSequence;
+    simulateImpulses(impulsesSequence, xEndSequence);
+    EXPECT_TRUE(xEnd.isApprox(xEndSequence, 1.0e-8));
+
+    // The impulses have an actual effect on the pendulum
+    vectorN_t xEndFree;
+    simulateImpulses({}, xEndFree);
+    EXPECT_FALSE(xEnd.isApprox(xEndFree, 1.0e-3));
+}
@@ -0,0 +1,119 @@
+// Test the piecewise-polynomial force profiles, evaluated with a cached interval,
+// and the tabulated profiles built on top of them, against direct interpolation.
+#include <gtest/gtest.h>
+
+#include "DoublePendulum.h"
+
+using namespace jiminy;
+
+namespace
+{
+    std::string const FRAME_NAME("SecondPendulumMass");
+
+    // Polynomial evaluated by searching the interval from scratch and summing the powers
+    vector3_t evaluatePolynomialRef(vectorN_t const & breakpoints,
+                                    matrixN_t const & coefficients,
+                                    float64_t const & t)
+    {
+        uint32_t const numIntervals = breakpoints.size() - 1;
+        uint32_t const numCoeffs = coefficients.cols() / numIntervals;
+        vector3_t F = vector3_t::Zero();
+        for (uint32_t k = 0; k < numIntervals; k++)
+        {
+            if (breakpoints[k] <= t && t < breakpoints[k + 1])
+            {
+                for (uint32_t j = 0; j < numCoeffs; j++)
+                {
+                    F += coefficients.col(k * numCoeffs + j) * std::pow(t - breakpoints[k], j);
+                }
+            }
+        }
+        return F;
+    }
+
+    // Linear interpolation between samples, zero outside of them
+    vector3_t interpolateRef(vectorN_t const & t,
+                             matrixN_t const & F,
+                             float64_t const & tIn)
+    {
+        for (int32_t k = 0; k < t.size() - 1; k++)
+        {
+            if (t[k] <= tIn && tIn < t[k + 1])
+            {
+                float64_t const ratio = (tIn - t[k]) / (t[k + 1] - t[k]);
+                return ((1.0 - ratio) * F.row(k) + ratio * F.row(k + 1)).transpose();
+            }
+        }
+        return vector3_t::Zero();
+    }
+}
+
+
+TEST(ForceProfile, PolynomialEvaluation)
+{
+    vectorN_t breakpoints(4);
+    breakpoints << 0.0, 0.5, 1.5, 2.0;
+    matrixN_t const coefficients = matrixN_t::Random(3, 3 * 4);
+    forceProfilePolynomial_t forceProfile;
+    ASSERT_EQ(forceProfile.initialize(FRAME_NAME, breakpoints, coefficients), result_t::SUCCESS);
+
+    // Increasing then decreasing time, on and around the breakpoints, before and after the profile
+    for (float64_t const & t : {0.1, 0.7, 1.6, 1.9, 0.2, 1.0, 0.5, 1.5, 0.0, 1.7,
+                                1.9999, 2.0, 2.5, 1.2, -0.1, 0.3})
+    {
+        vector3_t const F = forceProfile(t);
+        vector3_t const FRef = evaluatePolynomialRef(breakpoints, coefficients, t);
+        if (t < 0.0 || t >= 2.0)
+        {
+            EXPECT_TRUE(F.isZero(0.0)) << "Time " << t;
+        }
+        else
+        {
+            EXPECT_TRUE(F.isApprox(FRef, 1.0e-12)) << "Time " << t;
+        }
+    }
+
+    // Inconsistent inputs
+    EXPECT_NE(forceProfile.initialize(FRAME_NAME, breakpoints, matrixN_t::Random(3, 10)), result_t::SUCCESS);
+    breakpoints[2] = 0.5;
+    EXPECT_NE(forceProfile.initialize(FRAME_NAME, breakpoints, coefficients), result_t::SUCCESS);
+}
+
+TEST(ForceProfile, TabulatedMatchesInterpolation)
+{
+    vectorN_t t(4);
+    t << 0.1, 0.25, 0.4, 0.6;
+    matrixN_t F(4, 3);
+    F << 0.0, 0.0, 0.0,
+         10.0, 0.0, -5.0,
+         -4.0, 0.0, 8.0,
+         6.0, 0.0, 2.0;
+
+    // The simulation lasts beyond the last sample, where the force is zero
+    vectorN_t x0 = vectorN_t::Zero(4);
+    x0[0] = 0.5;
+    std::vector<vectorN_t> xEnd;
+    for (bool_t const & isTabulated : {true, false})
+    {
+        std::shared_ptr<Engine> engine = unit::buildDoublePendulumEngine();
+        if (isTabulated)
+        {
+            ASSERT_EQ(engine->registerForceProfileTabulated(FRAME_NAME, t, F), result_t::SUCCESS);
+        }
+        else
+        {
+            engine->registerForceProfile(FRAME_NAME,
+                [&t, &F](float64_t const & tIn, vectorN_t const & x) -> vector3_t
+                {
+                    return interpolateRef(t, F, tIn);
+                });
+        }
+        ASSERT_EQ(engine->simulate(0.8, x0), result_t::SUCCESS);
+        xEnd.push_back(engine->getStepperState().x);
+    }
+    EXPECT_TRUE(xEnd[0].isApprox(xEnd[1], 1.0e-8));
+
+    // Inconsistent samples
+    std::shared_ptr<Engine> engine = unit::buildDoublePendulumEngine();
+    EXPECT_NE(engine->registerForceProfileTabulated(FRAME_NAME, t, F.topRows(3)), result_t::SUCCESS);
+}
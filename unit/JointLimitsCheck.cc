@@ -0,0 +1,132 @@
+// Test the penalty forces enforcing the position and velocity limits of the joints,
+// computed for all the joints at once, against a reference computed joint by joint.
+#include <gtest/gtest.h>
+
+#include "DoublePendulum.h"
+
+using namespace jiminy;
+
+namespace
+{
+    // Engine exposing its internal dynamics
+    class JointLimitsEngine : public Engine
+    {
+    public:
+        using Engine::computeInternalDynamics;
+    };
+
+    // Penalty forces of the limits of the revolute joints, computed one DOF at a time
+    vectorN_t computeJointsLimitsForceRef(vectorN_t const & q,
+                                          vectorN_t const & v,
+                                          vectorN_t const & qMin,
+                                          vectorN_t const & qMax,
+                                          vectorN_t const & vMax,
+                                          float64_t const & stiffness,
+                                          float64_t const & damping,
+                                          float64_t const & transitionEps)
+    {
+        vectorN_t u = vectorN_t::Zero(v.size());
+        for (int32_t i = 0; i < v.size(); i++)
+        {
+            float64_t force = 0.0;
+            float64_t error = 0.0;
+            if (q[i] > qMax[i])
+            {
+                error = q[i] - qMax[i];
+                force = -stiffness * error - damping * std::max(v[i], 0.0);
+            }
+            else if (q[i] < qMin[i])
+            {
+                error = qMin[i] - q[i];
+                force = stiffness * error - damping * std::min(v[i], 0.0);
+            }
+            if (transitionEps > EPS)
+            {
+                force *= std::tanh(2 * error / transitionEps);
+            }
+            u[i] += clamp(force, -1e5, 1e5);
+
+            force = 0.0;
+            error = 0.0;
+            if (v[i] > vMax[i])
+            {
+                error = v[i] - vMax[i];
+                force = -damping * error;
+            }
+            else if (v[i] < -vMax[i])
+            {
+                error = -vMax[i] - v[i];
+                force = damping * error;
+            }
+            if (transitionEps > EPS)
+            {
+                force *= std::tanh(2 * error / transitionEps);
+            }
+            u[i] += clamp(force, -1e5, 1e5);
+        }
+        return u;
+    }
+}
+
+
+TEST(JointLimits, MatchesPerJointReference)
+{
+    std::shared_ptr<Model> model = unit::buildDoublePendulumModel();
+    configHolder_t mdlOptions = model->getOptions();
+    configHolder_t & jointOptions = boost::get<configHolder_t>(mdlOptions.at("joints"));
+    jointOptions.at("positionLimitFromUrdf") = false;
+    jointOptions.at("positionLimitMin") = (vectorN_t(2) << -0.5, -1.0).finished();
+    jointOptions.at("positionLimitMax") = (vectorN_t(2) << 0.5, 1.0).finished();
+    jointOptions.at("velocityLimitFromUrdf") = false;
+    jointOptions.at("velocityLimit") = (vectorN_t(2) << 2.0, 3.0).finished();
+    ASSERT_EQ(model->setOptions(mdlOptions), result_t::SUCCESS);
+
+    auto controller = std::make_shared<ControllerFunctor<decltype(unit::zeroTorque),
+                                                         decltype(unit::zeroTorque)> >(unit::zeroTorque, unit::zeroTorque);
+    controller->initialize(model);
+    JointLimitsEngine engine;
+    ASSERT_EQ(engine.initialize(model, controller, unit::alwaysContinue), result_t::SUCCESS);
+
+    // Positions and velocities within, on and beyond the limits, in both directions
+    std::vector<float64_t> const positions{-1.2, -1.0, -0.7, -0.5, -0.5005, 0.0, 0.5005, 0.7, 1.0, 1.2};
+    std::vector<float64_t> const velocities{-5.0, -3.0, -2.5, -1.0, 0.0, 1.0, 2.001, 3.0, 5.0};
+
+    for (float64_t const & transitionEps : {0.0, 1.0e-2})
+    {
+        configHolder_t engineOptions = engine.getOptions();
+        configHolder_t & engineJointOptions = boost::get<configHolder_t>(engineOptions.at("joints"));
+        engineJointOptions.at("boundTransitionEps") = transitionEps;
+        ASSERT_EQ(engine.setOptions(engineOptions), result_t::SUCCESS);
+        float64_t const stiffness = boost::get<float64_t>(engineJointOptions.at("boundStiffness"));
+        float64_t const damping = boost::get<float64_t>(engineJointOptions.at("boundDamping"));
+
+        ASSERT_EQ(engine.start(vectorN_t::Zero(4)), result_t::SUCCESS);
+        vectorN_t const & qMin = model->getPositionLimitMin();
+        vectorN_t const & qMax = model->getPositionLimitMax();
+        vectorN_t const & vMax = model->getVelocityLimit();
+        ASSERT_EQ(qMin[1], -1.0);
+        ASSERT_EQ(qMax[1], 1.0);
+        ASSERT_EQ(vMax[1], 3.0);
+
+        vectorN_t q(2);
+        vectorN_t v(2);
+        vectorN_t u(2);
+        for (float64_t const & qJoint : positions)
+        {
+            for (float64_t const & vJoint : velocities)
+            {
+                // The joints are in different states to check that each DOF is handled independently
+                q << qJoint, -qJoint;
+                v << vJoint, -0.5 * vJoint;
+                engine.computeInternalDynamics(0.0, q, v, u);
+                vectorN_t const uRef = computeJointsLimitsForceRef(
+                    q, v, qMin, qMax, vMax, stiffness, damping, transitionEps);
+                for (uint32_t i = 0; i < 2; i++)
+                {
+                    EXPECT_NEAR(u[i], uRef[i], 1.0e-9 * std::max(1.0, std::abs(uRef[i])));
+                }
+            }
+        }
+        engine.stop();
+    }
+}
@@ -0,0 +1,135 @@
+// Test the Runge-Kutta steppers on the configuration manifold, on the free rotation
+// of rigid bodies attached to a freeflyer and a spherical joint, along with an
+// unbounded rotary joint spinning at constant velocity.
+#include <pinocchio/fwd.hpp>
+#include <gtest/gtest.h>
+
+#include "pinocchio/multibody/model.hpp"
+
+#include "jiminy/core/Engine.h"
+
+using namespace jiminy;
+
+namespace
+{
+    vector3_t const INERTIA(1.0, 2.0, 3.0);
+    float64_t const DURATION = 2.0;
+
+    // Freeflyer, spherical and unbounded rotary joints, in this order
+    pinocchio::Model buildModel(void)
+    {
+        pinocchio::Model model;
+        pinocchio::JointIndex parentIdx = 0;
+        parentIdx = model.addJoint(parentIdx, pinocchio::JointModelFreeFlyer(), pinocchio::SE3::Identity(), "freeflyer");
+        parentIdx = model.addJoint(parentIdx, pinocchio::JointModelSpherical(), pinocchio::SE3::Identity(), "spherical");
+        parentIdx = model.addJoint(parentIdx, pinocchio::JointModelRUBZ(), pinocchio::SE3::Identity(), "unbounded");
+        return model;
+    }
+
+    /* Euler equations of torque-free rigid bodies in local frame, the velocity of the
+       unbounded rotary joint being constant. */
+    void computeDynamics(pinocchio::Model const & model,
+                         vectorN_t        const & x,
+                         vectorN_t              & dxdt)
+    {
+        int32_t const & nq = model.nq;
+        int32_t const & nv = model.nv;
+        dxdt.setZero(nq + nv);
+        computePositionDerivative(model, x.head(nq), x.tail(nv), dxdt.head(nq));
+        auto const v = x.tail(nv);
+        auto a = dxdt.tail(nv);
+        for (int32_t const & idx_v : {3, 6})
+        {
+            vector3_t const omega = v.segment<3>(idx_v);
+            a.segment<3>(idx_v) = (- omega.cross(INERTIA.cwiseProduct(omega))).cwiseQuotient(INERTIA);
+        }
+        a.head<3>() = - v.segment<3>(3).cross(v.head<3>());
+    }
+
+    vectorN_t getInitialState(pinocchio::Model const & model)
+    {
+        vectorN_t x = vectorN_t::Zero(model.nq + model.nv);
+        x[6] = 1.0;
+        x[10] = 1.0;
+        x[11] = 1.0;
+        x.tail(model.nv) << 0.3, -0.2, 1.0, 1.0, 0.1, -0.5, -0.4, 0.8, 0.2, 2.0;
+        return x;
+    }
+
+    vectorN_t simulate(runge_kutta_lie         stepper,
+                       pinocchio::Model const & model,
+                       float64_t        const & stepSize)
+    {
+        auto system = [&model](vectorN_t const & x, vectorN_t & dxdt, float64_t const & t)
+                      {
+                          computeDynamics(model, x, dxdt);
+                      };
+        vectorN_t x = getInitialState(model);
+        vectorN_t dxdt;
+        system(x, dxdt, 0.0);
+        float64_t t = 0.0;
+        float64_t dt = stepSize;
+        while (t < DURATION - EPS)
+        {
+            dt = std::min(dt, DURATION - t);
+            stepper.try_step(system, x, dxdt, t, dt);
+        }
+        return x;
+    }
+
+    // Angular momentum in world frame of the body attached to the quaternion and velocity
+    vector3_t getAngularMomentum(vectorN_t const & x,
+                                 int32_t   const & quatIdx,
+                                 int32_t   const & omegaIdx)
+    {
+        Eigen::Map<quaternion_t const> const quat(x.data() + quatIdx);
+        return quat._transformVector(INERTIA.cwiseProduct(x.segment<3>(omegaIdx)));
+    }
+}
+
+
+TEST(LieStepper, InvariantsAndConvergence)
+{
+    pinocchio::Model const model = buildModel();
+    int32_t const & nq = model.nq;
+    vectorN_t const x0 = getInitialState(model);
+
+    // Only the freeflyer and the spherical joints are corrected, without error for the other ones
+    testing::internal::CaptureStdout();
+    runge_kutta_lie const stepperRef = runge_kutta_lie::dopri5(model, 1.0e-12, 1.0e-12);
+    runge_kutta_lie const stepperRk4 = runge_kutta_lie::rk4(model);
+    EXPECT_TRUE(testing::internal::GetCapturedStdout().empty());
+
+    // Steppers along with the expected accuracy of the simulation
+    std::vector<std::pair<runge_kutta_lie, float64_t> > const steppers{
+        {runge_kutta_lie::dopri5(model, 1.0e-6, 1.0e-6), 1.0e-5},
+        {runge_kutta_lie::dopri5(model, 1.0e-9, 1.0e-9), 1.0e-8},
+        {stepperRk4, 1.0e-8}};
+    for (std::pair<runge_kutta_lie, float64_t> const & stepperTol : steppers)
+    {
+        vectorN_t const x = simulate(stepperTol.first, model, 1.0e-2);
+
+        // The quaternions and the orientation of the unbounded joint stay normalized by construction
+        EXPECT_NEAR(x.segment<4>(3).norm(), 1.0, 1.0e-12);
+        EXPECT_NEAR(x.segment<4>(7).norm(), 1.0, 1.0e-12);
+        EXPECT_NEAR(x.segment<2>(11).norm(), 1.0, 1.0e-12);
+
+        // The angular momentum in world frame is conserved, and so is the linear momentum of the freeflyer
+        float64_t const tol = stepperTol.second;
+        EXPECT_TRUE(getAngularMomentum(x, 3, nq + 3).isApprox(getAngularMomentum(x0, 3, nq + 3), tol));
+        EXPECT_TRUE(getAngularMomentum(x, 7, nq + 6).isApprox(getAngularMomentum(x0, 7, nq + 6), tol));
+        Eigen::Map<quaternion_t const> const quat(x.data() + 3);
+        EXPECT_TRUE(quat._transformVector(x.segment<3>(nq)).isApprox(x0.segment<3>(nq), tol));
+
+        // The unbounded joint spins at constant velocity
+        float64_t const angle = x0[nq + 9] * DURATION;
+        EXPECT_NEAR(x[11], std::cos(angle), tol);
+        EXPECT_NEAR(x[12], std::sin(angle), tol);
+    }
+
+    // The classic Runge-Kutta scheme is of order 4
+    vectorN_t const xRef = simulate(stepperRef, model, 1.0e-3);
+    float64_t const errorCoarse = (simulate(stepperRk4, model, 0.1) - xRef).norm();
+    float64_t const errorFine = (simulate(stepperRk4, model, 0.05) - xRef).norm();
+    EXPECT_NEAR(errorCoarse / errorFine, 16.0, 2.0);
+}
@@ -0,0 +1,42 @@
+// Test the round trip of the model description through its binary cache file.
+#include <cstdio>
+#include <gtest/gtest.h>
+
+#include "jiminy/core/Model.h"
+
+#include "DoublePendulum.h"
+
+using namespace jiminy;
+
+namespace
+{
+    std::string const CACHE_PATH("double_pendulum_rigid.cache");
+}
+
+
+TEST(ModelCache, RoundTrip)
+{
+    std::remove(CACHE_PATH.c_str());
+
+    // Parse the URDF file and generate the cache
+    ModelDescription description;
+    ASSERT_EQ(description.initialize(unit::DOUBLE_PENDULUM_URDF, false, CACHE_PATH), result_t::SUCCESS);
+
+    // Load the description back from the cache
+    ModelDescription descriptionCached;
+    ASSERT_EQ(descriptionCached.load(CACHE_PATH, unit::DOUBLE_PENDULUM_URDF, false), result_t::SUCCESS);
+    EXPECT_EQ(descriptionCached.urdfPath, description.urdfPath);
+    EXPECT_EQ(descriptionCached.hasFreeflyer, description.hasFreeflyer);
+    EXPECT_EQ(descriptionCached.rigidJointsNames, description.rigidJointsNames);
+    EXPECT_EQ(descriptionCached.key, description.key);
+    EXPECT_TRUE(descriptionCached.pncModelRigid == description.pncModelRigid);
+
+    // A model initialized from the cache behaves like one parsing the URDF file
+    auto model = std::make_shared<Model>();
+    ASSERT_EQ(model->initialize(unit::DOUBLE_PENDULUM_URDF, false, CACHE_PATH), result_t::SUCCESS);
+    EXPECT_EQ(model->getRigidJointsNames(), description.rigidJointsNames);
+
+    // The cache is stale for another freeflyer flag
+    EXPECT_NE(descriptionCached.load(CACHE_PATH, unit::DOUBLE_PENDULUM_URDF, true), result_t::SUCCESS);
+    EXPECT_EQ(std::remove(CACHE_PATH.c_str()), 0);
+}
@@ -0,0 +1,89 @@
+// Test that the motors gathered in banks compute the same torques at once as
+// they do one by one.
+#include <gtest/gtest.h>
+
+#include "DoublePendulum.h"
+
+using namespace jiminy;
+
+namespace
+{
+    // Simple motor computing the torques of its bank one motor at a time
+    class ScalarSimpleMotor : public SimpleMotor
+    {
+    public:
+        using SimpleMotor::SimpleMotor;
+
+    protected:
+        virtual result_t computeEffortBank(float64_t                            const & t,
+                                           MotorSharedDataHolder_t::motorBank_t       & bank) override
+        {
+            return AbstractMotorBase::computeEffortBank(t, bank);
+        }
+    };
+
+    // Double pendulum whose first motor is saturated, and whose second one has friction
+    template<typename MotorType>
+    std::shared_ptr<Model> buildModel(void)
+    {
+        auto model = std::make_shared<Model>();
+        model->initialize(unit::DOUBLE_PENDULUM_URDF, false);
+        for (std::string const & jointName : unit::DOUBLE_PENDULUM_JOINTS)
+        {
+            auto motor = std::make_shared<MotorType>(jointName);
+            model->attachMotor(motor);
+            motor->initialize(jointName);
+        }
+
+        configHolder_t motorOptions = model->getMotors()[0]->getOptions();
+        motorOptions.at("torqueLimitFromUrdf") = false;
+        motorOptions.at("torqueLimit") = 2.0;
+        model->getMotors()[0]->setOptions(motorOptions);
+
+        motorOptions = model->getMotors()[1]->getOptions();
+        motorOptions.at("enableTorqueLimit") = false;
+        motorOptions.at("enableFriction") = true;
+        motorOptions.at("frictionViscousPositive") = -0.5;
+        motorOptions.at("frictionViscousNegative") = -0.3;
+        motorOptions.at("frictionDryPositive") = -1.0;
+        motorOptions.at("frictionDryNegative") = -0.8;
+        motorOptions.at("frictionDrySlope") = 20.0;
+        model->getMotors()[1]->setOptions(motorOptions);
+
+        // The banks must be gathered again since the options have changed
+        model->getMotors()[0]->refreshBanks();
+
+        return model;
+    }
+}
+
+
+TEST(MotorBank, SimpleMotorMatchesScalar)
+{
+    std::shared_ptr<Model> model = buildModel<SimpleMotor>();
+    std::shared_ptr<Model> modelScalar = buildModel<ScalarSimpleMotor>();
+
+    vectorN_t const q = vectorN_t::Zero(2);
+    vectorN_t const a = vectorN_t::Zero(2);
+    for (float64_t const & vJoint : {-1.0, -1.0e-3, 0.0, 1.0e-3, 0.5})
+    {
+        for (float64_t const & uJoint : {-5.0, -2.0, 0.3, 2.0, 5.0})
+        {
+            vectorN_t const v = vectorN_t::Constant(2, vJoint);
+            vectorN_t const uCommand = vectorN_t::Constant(2, uJoint);
+            model->computeMotorsTorques(0.0, q, v, a, uCommand);
+            modelScalar->computeMotorsTorques(0.0, q, v, a, uCommand);
+            vectorN_t const & u = model->getMotorsTorques();
+            vectorN_t const & uScalar = modelScalar->getMotorsTorques();
+
+            // Only the saturation applies to the first motor, and only the friction to the second one
+            EXPECT_EQ(u[0], clamp(uJoint, -2.0, 2.0));
+            EXPECT_NEAR(u[0], uScalar[0], 1.0e-12);
+            EXPECT_NEAR(u[1], uScalar[1], 1.0e-12);
+            if (vJoint == 0.0)
+            {
+                EXPECT_EQ(u[1], uJoint);
+            }
+        }
+    }
+}
@@ -0,0 +1,60 @@
+// Test the analytical derivative of the configuration vector against the finite
+// differences of the integration of Pinocchio, for every type of joint.
+#include <gtest/gtest.h>
+
+#include "pinocchio/multibody/model.hpp"
+#include "pinocchio/algorithm/joint-configuration.hpp"
+
+#include "jiminy/core/Utilities.h"
+
+using namespace jiminy;
+
+
+TEST(PositionDerivative, MatchesIntegrate)
+{
+    // Build a kinematic chain gathering every type of joint
+    pinocchio::JointModelComposite jointComposite;
+    jointComposite.addJoint(pinocchio::JointModelRX());
+    jointComposite.addJoint(pinocchio::JointModelSpherical());
+    pinocchio::Model model;
+    pinocchio::JointIndex parentIdx = 0;
+    auto addJoint = [&model, &parentIdx](pinocchio::JointModel const & joint)
+                    {
+                        parentIdx = model.addJoint(parentIdx, joint, pinocchio::SE3::Identity(),
+                                                   "joint_" + std::to_string(parentIdx));
+                    };
+    addJoint(pinocchio::JointModelFreeFlyer());
+    addJoint(pinocchio::JointModelSpherical());
+    addJoint(pinocchio::JointModelPlanar());
+    addJoint(pinocchio::JointModelRX());
+    addJoint(pinocchio::JointModelPY());
+    addJoint(pinocchio::JointModelRUBX());
+    addJoint(pinocchio::JointModelRUBY());
+    addJoint(pinocchio::JointModelRUBZ());
+    addJoint(pinocchio::JointModelSphericalZYX());
+    addJoint(pinocchio::JointModelTranslation());
+    addJoint(pinocchio::JointModelRevoluteUnaligned(vector3_t(1.0, 2.0, 3.0).normalized()));
+    addJoint(jointComposite);
+
+    // Random configuration and velocity, away from the neutral configuration
+    vectorN_t q(model.nq);
+    pinocchio::integrate(model, pinocchio::neutral(model), vectorN_t::Random(model.nv), q);
+    vectorN_t const v = vectorN_t::Random(model.nv);
+
+    vectorN_t qDot = vectorN_t::Constant(model.nq, std::numeric_limits<float64_t>::quiet_NaN());
+    computePositionDerivative(model, q, v, qDot);
+
+    float64_t const dt = 1.0e-6;
+    vectorN_t qPlus(model.nq);
+    vectorN_t qMinus(model.nq);
+    pinocchio::integrate(model, q, dt * v, qPlus);
+    pinocchio::integrate(model, q, - dt * v, qMinus);
+    vectorN_t const qDotRef = (qPlus - qMinus) / (2 * dt);
+
+    for (int32_t i = 1; i < model.njoints; i++)
+    {
+        auto const & joint = model.joints[i];
+        EXPECT_TRUE(qDot.segment(joint.idx_q(), joint.nq()).isApprox(
+            qDotRef.segment(joint.idx_q(), joint.nq()), 1.0e-6)) << "Joint " << joint.shortname();
+    }
+}
@@ -0,0 +1,54 @@
+// Test the counter-based generator of the sensor noise: the samples only depend
+// on the seed and the stream of the generators, not on the calling thread.
+#include <thread>
+#include <gtest/gtest.h>
+
+#include "jiminy/core/Utilities.h"
+
+using namespace jiminy;
+
+
+TEST(RandomGenerator, StreamReproducibility)
+{
+    randomGeneratorState_t state;
+    matrixN_t samplesRef(3, 4);
+    resetRandGenerators(state, 1U, 0U);
+    {
+        ScopedRandomGeneratorState stateGuard(state);
+        randMatrixNormal(samplesRef);
+    }
+
+    // Drawing from another thread gives the same samples
+    matrixN_t samples(3, 4);
+    resetRandGenerators(state, 1U, 0U);
+    std::thread worker([&state, &samples]()
+                       {
+                           ScopedRandomGeneratorState stateGuard(state);
+                           randMatrixNormal(samples);
+                       });
+    worker.join();
+    EXPECT_TRUE(samples == samplesRef);
+
+    // Drawing in several calls gives the same samples, as long as they are multiple of the block size
+    resetRandGenerators(state, 1U, 0U);
+    {
+        ScopedRandomGeneratorState stateGuard(state);
+        for (uint32_t i = 0; i < 3; i++)
+        {
+            matrixN_t sample(1, 4);
+            randMatrixNormal(sample);
+            samples.row(i) = sample;
+        }
+    }
+    matrixN_t const samplesRefRowMajor = Eigen::Map<matrixN_t const>(samplesRef.data(), 4, 3).transpose();
+    EXPECT_TRUE(samples == samplesRefRowMajor);
+
+    // Other streams and seeds give independent samples
+    for (std::pair<uint32_t, uint32_t> const & seedStream : {std::make_pair(1U, 1U), std::make_pair(2U, 0U)})
+    {
+        resetRandGenerators(state, seedStream.first, seedStream.second);
+        ScopedRandomGeneratorState stateGuard(state);
+        randMatrixNormal(samples);
+        EXPECT_FALSE(samples.isApprox(samplesRef));
+    }
+}
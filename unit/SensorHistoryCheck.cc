@@ -0,0 +1,125 @@
+// Test the ring buffers storing the history of the sensors data, shared by the
+// sensors of the same type.
+#include <pinocchio/fwd.hpp>
+#include <gtest/gtest.h>
+
+#include "jiminy/core/AbstractSensor.h"
+
+using namespace jiminy;
+
+namespace
+{
+    uint32_t const DATA_SIZE = 3U;
+    int32_t const NUM_SENSORS = 2;
+
+    // Append a sample whose data are filled with its timestamp, offset by the sensor index
+    void pushSample(SensorSharedDataHolder_t       & holder,
+                    float64_t                const & t)
+    {
+        holder.pushBackHistory();
+        holder.time(holder.historySize_ - 1) = t;
+        for (int32_t k = 0; k < NUM_SENSORS; k++)
+        {
+            holder.data(holder.historySize_ - 1, k).setConstant(t + k);
+        }
+    }
+
+    // Check that the history holds the samples of consecutive timestamps, starting from tFirst
+    void checkHistory(SensorSharedDataHolder_t       & holder,
+                      float64_t                const & tFirst)
+    {
+        for (uint32_t i = 0; i < holder.historySize_; i++)
+        {
+            float64_t const t = tFirst + i;
+            EXPECT_EQ(holder.time(i), t);
+            for (int32_t k = 0; k < NUM_SENSORS; k++)
+            {
+                EXPECT_TRUE((holder.data(i, k).array() == t + k).all());
+            }
+        }
+    }
+}
+
+
+TEST(SensorHistory, RingBufferWrapAndGrowth)
+{
+    SensorSharedDataHolder_t holder;
+    holder.num_ = NUM_SENSORS;
+    holder.clearHistory(DATA_SIZE, 4U);
+    ASSERT_EQ(holder.time_.size(), 4);
+    ASSERT_EQ(holder.data_.cols(), 4 * NUM_SENSORS);
+    EXPECT_EQ(holder.time(0), -1.0);
+    EXPECT_EQ(holder.time(1), 0.0);
+    for (int32_t k = 0; k < NUM_SENSORS; k++)
+    {
+        EXPECT_TRUE(holder.data(1, k).isZero());
+        holder.data(0, k).setConstant(-1.0 + k);
+        holder.data(1, k).setConstant(k);
+    }
+
+    // Keep three samples at most, so that the head wraps around several times without growing
+    for (uint32_t i = 1; i <= 10; i++)
+    {
+        if (holder.historySize_ == 3)
+        {
+            holder.popFrontHistory();
+        }
+        pushSample(holder, i);
+        ASSERT_EQ(holder.time_.size(), 4);
+        checkHistory(holder, i + 1.0 - holder.historySize_);
+    }
+    EXPECT_EQ(holder.historyFirst_, 9U);
+    EXPECT_NE(holder.historyHead_, 0U);
+
+    // Fill up the buffers from a wrapped head, so that they are unrolled while growing
+    for (uint32_t i = 11; i <= 13; i++)
+    {
+        pushSample(holder, i);
+    }
+    EXPECT_EQ(holder.time_.size(), 8);
+    EXPECT_EQ(holder.data_.cols(), 8 * NUM_SENSORS);
+    EXPECT_EQ(holder.historySize_, 6U);
+    checkHistory(holder, 8.0);
+
+    // The capacity is kept by the next reset
+    holder.clearHistory(DATA_SIZE, 4U);
+    EXPECT_EQ(holder.time_.size(), 8);
+    EXPECT_EQ(holder.historySize_, 2U);
+    EXPECT_EQ(holder.historyFirst_, 0U);
+}
+
+TEST(SensorHistory, DelayCursorBackInTime)
+{
+    SensorSharedDataHolder_t holder;
+    holder.num_ = NUM_SENSORS;
+    holder.delayGroups_.push_back({0.5, 0U, {0, 1}, 0U});
+    SensorSharedDataHolder_t::delayGroup_t & group = holder.delayGroups_[0];
+    holder.clearHistory(DATA_SIZE, 4U);
+    for (uint32_t i = 1; i <= 10; i++)
+    {
+        pushSample(holder, i);
+    }
+
+    // The oldest sample is at time -1
+    EXPECT_EQ(holder.findDelayedIdx(group, -1.5), -1);
+    EXPECT_EQ(holder.time(holder.findDelayedIdx(group, 7.5)), 7.0);
+    EXPECT_EQ(holder.time(holder.findDelayedIdx(group, 9.0)), 9.0);
+
+    // The solver goes back in time, so that the cursor is beyond the last sample
+    while (holder.time(holder.historySize_ - 1) > 4.0)
+    {
+        holder.popBackHistory();
+    }
+    EXPECT_EQ(holder.time(holder.findDelayedIdx(group, 3.5)), 3.0);
+    pushSample(holder, 4.5);
+    EXPECT_EQ(holder.time(holder.findDelayedIdx(group, 4.7)), 4.5);
+
+    // The cursor remains valid when the oldest samples are dropped
+    holder.popFrontHistory();
+    holder.popFrontHistory();
+    holder.popFrontHistory();
+    EXPECT_EQ(holder.time(0), 2.0);
+    EXPECT_EQ(holder.time(holder.findDelayedIdx(group, 4.0)), 4.0);
+    EXPECT_EQ(holder.time(holder.findDelayedIdx(group, 2.2)), 2.0);
+    EXPECT_EQ(holder.time(holder.findDelayedIdx(group, 10.0)), 4.5);
+}
@@ -0,0 +1,99 @@
+// Test the round trip of the simulation logs through a dataset file, and the
+// robustness of the dataset to truncated files.
+#include <fstream>
+#include <iterator>
+#include <gtest/gtest.h>
+
+#include "jiminy/core/TelemetryDataset.h"
+
+#include "DoublePendulum.h"
+
+using namespace jiminy;
+
+namespace
+{
+    std::string const DATASET_PATH("dataset_check.bin");
+}
+
+
+TEST(TelemetryDataset, RoundTrip)
+{
+    std::shared_ptr<Engine> engine = unit::buildDoublePendulumEngine();
+    vectorN_t x0 = vectorN_t::Zero(4);
+    x0(0) = 1.0;
+
+    // Append two episodes of different durations
+    TelemetryDataset dataset;
+    ASSERT_EQ(dataset.open(DATASET_PATH, OpenMode::WRITE_ONLY | OpenMode::TRUNCATE), result_t::SUCCESS);
+    std::vector<matrixN_t> logsData;
+    std::vector<std::string> header;
+    for (float64_t const & tEnd : {0.2, 0.5})
+    {
+        ASSERT_EQ(engine->simulate(tEnd, x0), result_t::SUCCESS);
+        matrixN_t logData;
+        engine->getLogData(header, logData);
+        logsData.push_back(logData);
+        ASSERT_EQ(engine->writeLogDataset(dataset), result_t::SUCCESS);
+    }
+    dataset.close();
+
+    // Read them back
+    ASSERT_EQ(dataset.open(DATASET_PATH, OpenMode::READ_ONLY), result_t::SUCCESS);
+    ASSERT_EQ(dataset.getNumEpisodes(), 2);
+    int32_t const energyIdx = dataset.getColumnIdx("HighLevelController.energy");
+    ASSERT_GT(energyIdx, 0);
+    for (uint32_t i = 0; i < logsData.size(); i++)
+    {
+        matrixN_t episodeData;
+        ASSERT_EQ(dataset.getEpisodeData(i, episodeData), result_t::SUCCESS);
+        ASSERT_EQ(episodeData.rows(), logsData[i].rows());
+        ASSERT_EQ(episodeData.cols(), logsData[i].cols());
+        EXPECT_TRUE(episodeData.isApprox(logsData[i]));
+        vectorN_t const energy = Engine::getLogFieldValue("HighLevelController.energy", header, logsData[i]);
+        EXPECT_TRUE(episodeData.col(energyIdx).isApprox(energy));
+    }
+
+    // The views remain valid after closing the dataset as long as the mapping is shared
+    int32_t const columnIdx = dataset.getNumIntEntries();
+    datasetColumn_t<float32_t> const column = dataset.getFloatColumn(1, columnIdx);
+    vectorN_t const columnExpected = column.cast<float64_t>();
+    std::shared_ptr<char_t const> mapping = dataset.getMapping();
+    dataset.close();
+    EXPECT_TRUE(column.cast<float64_t>().isApprox(columnExpected));
+    EXPECT_TRUE(columnExpected.isApprox(logsData[1].col(columnIdx)));
+}
+
+TEST(TelemetryDataset, TruncatedFile)
+{
+    std::shared_ptr<Engine> engine = unit::buildDoublePendulumEngine();
+    vectorN_t x0 = vectorN_t::Zero(4);
+    ASSERT_EQ(engine->simulate(0.2, x0), result_t::SUCCESS);
+
+    TelemetryDataset dataset;
+    ASSERT_EQ(dataset.open(DATASET_PATH, OpenMode::WRITE_ONLY | OpenMode::TRUNCATE), result_t::SUCCESS);
+    ASSERT_EQ(engine->writeLogDataset(dataset), result_t::SUCCESS);
+    dataset.close();
+
+    std::ifstream file(DATASET_PATH, std::ios::binary);
+    std::vector<char_t> content((std::istreambuf_iterator<char_t>(file)), std::istreambuf_iterator<char_t>());
+    file.close();
+
+    // Every truncation must be detected, without reading outside of the file
+    std::string const truncatedPath = "truncated_" + DATASET_PATH;
+    for (std::size_t size : {std::size_t(1), sizeof(datasetPreamble_t), content.size() / 2, content.size() - 1})
+    {
+        std::ofstream truncatedFile(truncatedPath, std::ios::binary | std::ios::trunc);
+        truncatedFile.write(content.data(), size);
+        truncatedFile.close();
+        EXPECT_NE(dataset.open(truncatedPath, OpenMode::READ_ONLY), result_t::SUCCESS);
+        EXPECT_FALSE(dataset.isOpen());
+    }
+
+    // Corrupted size of the header
+    std::vector<char_t> corrupted = content;
+    reinterpret_cast<datasetPreamble_t *>(corrupted.data())->headerSize = content.size();
+    std::ofstream corruptedFile(truncatedPath, std::ios::binary | std::ios::trunc);
+    corruptedFile.write(corrupted.data(), corrupted.size());
+    corruptedFile.close();
+    EXPECT_NE(dataset.open(truncatedPath, OpenMode::READ_ONLY), result_t::SUCCESS);
+}